@@ -0,0 +1,395 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   Benchmark driver for pair style lj/eten and its variants.
+
+   Builds boxes of synthetic 56 bead Go chains, one atom type per bead
+   and shared by all chains, with native contacts taken from the
+   generated conformation, and times for every pair style and size:
+     compute() with and without energy  (ns per listed pair)
+     compute_inner/middle/outer() under run_style respa  (ns per pair)
+     single()  (ns per call)
+     neighbor list builds  (ms per build)
+     full MD steps with fix nve + langevin  (steps/s)
+   lj/cut on the same system is the baseline.
+
+   Build against a LAMMPS library with the lj/eten sources installed:
+     mpicxx -O2 -std=c++17 -I${LAMMPS}/src bench_lj_eten.cpp \
+            -L${LAMMPS}/build -llammps -o bench_lj_eten
+   Run:
+     mpirun -np 1 ./bench_lj_eten [-sizes 56,560,5600,56000,100000]
+            [-styles "lj/cut;lj/eten;lj/eten/opt"] [-nrep 100] [-nsteps 1000]
+            [-seed 12345] [-lmp "<extra LAMMPS command line flags>"]
+   every -styles entry is "style [keywords]", e.g. "lj/eten native 6.0 0.1".
+------------------------------------------------------------------------- */
+
+#include "atom.h"
+#include "force.h"
+#include "input.h"
+#include "lammps.h"
+#include "neigh_list.h"
+#include "neighbor.h"
+#include "pair.h"
+#include "platform.h"
+
+#include <mpi.h>
+
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace LAMMPS_NS;
+
+static constexpr int NBEAD = 56;          // beads per chain, protein G sized
+static constexpr double BOND = 3.8;       // C-alpha bond length (Angstrom)
+static constexpr double RSPHERE = 12.0;   // confinement radius of one chain
+static constexpr double SPACING = 32.0;   // lattice spacing of the chains
+static constexpr double RNATIVE = 8.0;    // native contact distance
+static constexpr double EPS_NATIVE = 0.5;    // kcal/mol
+static constexpr double EPS_REP = 0.1;       // kcal/mol
+static constexpr double SIGMA_REP = 4.0;
+static constexpr double CUTOFF = 15.0;    // as in Inputs/Go_LAMMPS
+
+typedef std::array<double, 3> Vec;
+
+/* ----------------------------------------------------------------------
+   compact self-avoiding random walk of NBEAD beads inside a sphere
+------------------------------------------------------------------------- */
+
+static std::vector<Vec> make_chain(std::mt19937 &rng)
+{
+  std::normal_distribution<double> gauss(0.0, 1.0);
+  std::vector<Vec> x(1, Vec{0.0, 0.0, 0.0});
+
+  while ((int) x.size() < NBEAD) {
+    const Vec &last = x.back();
+    Vec trial{};
+    bool ok = false;
+    for (int attempt = 0; attempt < 1000 && !ok; attempt++) {
+      Vec d{gauss(rng), gauss(rng), gauss(rng)};
+      double len = sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+      for (int k = 0; k < 3; k++) trial[k] = last[k] + BOND * d[k] / len;
+      if (trial[0] * trial[0] + trial[1] * trial[1] + trial[2] * trial[2] > RSPHERE * RSPHERE) continue;
+      ok = true;
+      for (std::size_t n = 0; n + 1 < x.size() && ok; n++) {
+        double dx = trial[0] - x[n][0], dy = trial[1] - x[n][1], dz = trial[2] - x[n][2];
+        if (dx * dx + dy * dy + dz * dz < SIGMA_REP * SIGMA_REP) ok = false;
+      }
+    }
+
+    // a walk trapped by its own beads starts over
+
+    if (ok) x.push_back(trial);
+    else x.resize(1);
+  }
+  return x;
+}
+
+/* ----------------------------------------------------------------------
+   write a data file of nchain rotated copies of the chain on a cubic
+   lattice and a pair_coeff file for the 12-10-6 Go potential
+   U = eps (13 (s/r)^12 - 18 (s/r)^10 + 4 (s/r)^6) of the native pairs,
+   with its minimum -eps at r = s, and eps_rep (s_rep/r)^12 otherwise
+------------------------------------------------------------------------- */
+
+static void write_system(const std::string &datafile, const std::string &coefffile, int nchain,
+                         unsigned seed)
+{
+  std::mt19937 rng(seed);
+  std::normal_distribution<double> gauss(0.0, 1.0);
+  const std::vector<Vec> chain = make_chain(rng);
+
+  int nside = 1;
+  while (nside * nside * nside < nchain) nside++;
+  const double len = nside * SPACING;
+
+  FILE *fp = fopen(datafile.c_str(), "w");
+  if (!fp) {
+    fprintf(stderr, "Cannot write %s\n", datafile.c_str());
+    MPI_Abort(MPI_COMM_WORLD, 1);
+  }
+  fprintf(fp, "LAMMPS data file: %d synthetic Go chains of %d beads\n\n", nchain, NBEAD);
+  fprintf(fp, "%d atoms\n%d bonds\n%d atom types\n1 bond types\n\n", nchain * NBEAD, nchain * (NBEAD - 1),
+          NBEAD);
+  fprintf(fp, "0 %g xlo xhi\n0 %g ylo yhi\n0 %g zlo zhi\n\n", len, len, len);
+  fprintf(fp, "Masses\n\n");
+  for (int t = 1; t <= NBEAD; t++) fprintf(fp, "%d 110.0\n", t);
+  fprintf(fp, "\nBond Coeffs # harmonic\n\n1 50.0 %g\n", BOND);
+
+  fprintf(fp, "\nAtoms # bond\n\n");
+  for (int c = 0; c < nchain; c++) {
+    // random rotation from a unit quaternion
+
+    double q[4] = {gauss(rng), gauss(rng), gauss(rng), gauss(rng)};
+    double qn = sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    for (double &v : q) v /= qn;
+    const double r[3][3] = {
+        {1 - 2 * (q[2] * q[2] + q[3] * q[3]), 2 * (q[1] * q[2] - q[0] * q[3]), 2 * (q[1] * q[3] + q[0] * q[2])},
+        {2 * (q[1] * q[2] + q[0] * q[3]), 1 - 2 * (q[1] * q[1] + q[3] * q[3]), 2 * (q[2] * q[3] - q[0] * q[1])},
+        {2 * (q[1] * q[3] - q[0] * q[2]), 2 * (q[2] * q[3] + q[0] * q[1]), 1 - 2 * (q[1] * q[1] + q[2] * q[2])}};
+    const double center[3] = {(c % nside + 0.5) * SPACING, ((c / nside) % nside + 0.5) * SPACING,
+                              (c / (nside * nside) + 0.5) * SPACING};
+
+    for (int b = 0; b < NBEAD; b++) {
+      double x[3];
+      for (int k = 0; k < 3; k++)
+        x[k] = center[k] + r[k][0] * chain[b][0] + r[k][1] * chain[b][1] + r[k][2] * chain[b][2];
+      fprintf(fp, "%d %d %d %.6f %.6f %.6f\n", c * NBEAD + b + 1, c + 1, b + 1, x[0], x[1], x[2]);
+    }
+  }
+
+  fprintf(fp, "\nBonds\n\n");
+  for (int c = 0; c < nchain; c++)
+    for (int b = 0; b < NBEAD - 1; b++)
+      fprintf(fp, "%d 1 %d %d\n", c * (NBEAD - 1) + b + 1, c * NBEAD + b + 1, c * NBEAD + b + 2);
+  fclose(fp);
+
+  fp = fopen(coefffile.c_str(), "w");
+  if (!fp) {
+    fprintf(stderr, "Cannot write %s\n", coefffile.c_str());
+    MPI_Abort(MPI_COMM_WORLD, 1);
+  }
+  fprintf(fp, "# i j A B C for pair_coeff * * file\n");
+  for (int i = 0; i < NBEAD; i++)
+    for (int j = i; j < NBEAD; j++) {
+      double dx = chain[i][0] - chain[j][0], dy = chain[i][1] - chain[j][1], dz = chain[i][2] - chain[j][2];
+      double rij = sqrt(dx * dx + dy * dy + dz * dz);
+      if ((j - i >= 3) && (rij < RNATIVE)) {
+        double s2 = rij * rij, s6 = s2 * s2 * s2;
+        fprintf(fp, "%d %d %.10g %.10g %.10g\n", i + 1, j + 1, 13.0 * EPS_NATIVE * s6 * s6,
+                18.0 * EPS_NATIVE * s6 * s2 * s2, 4.0 * EPS_NATIVE * s6);
+      } else {
+        double s6 = pow(SIGMA_REP, 6.0);
+        fprintf(fp, "%d %d %.10g 0.0 0.0\n", i + 1, j + 1, EPS_REP * s6 * s6);
+      }
+    }
+  fclose(fp);
+}
+
+/* ----------------------------------------------------------------------
+   one benchmark case: pair style setup, then timings
+------------------------------------------------------------------------- */
+
+struct Timing {
+  double npair, e_on, e_off, inner, middle, outer, single, neigh, steps;
+};
+
+static double walltime_sync()
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  return platform::walltime();
+}
+
+static void setup_system(LAMMPS *lmp, const std::string &style, const std::string &datafile,
+                         const std::string &coefffile, bool respa)
+{
+  std::istringstream words(style);
+  std::string name, keywords, w;
+  words >> name;
+  while (words >> w) keywords += " " + w;
+
+  lmp->input->one("clear");
+  lmp->input->one("units real");
+  lmp->input->one("atom_style bond");
+  lmp->input->one("bond_style harmonic");
+  lmp->input->one("special_bonds lj 0.0 0.0 0.0");
+  lmp->input->one("neigh_modify delay 0 every 1 check yes");
+  if (name.find("/omp") != std::string::npos) lmp->input->one("package omp 0");
+  lmp->input->one("pair_style " + name + " " + std::to_string(CUTOFF) + keywords);
+  lmp->input->one("read_data " + datafile);
+  if (name.rfind("lj/eten", 0) == 0)
+    lmp->input->one("pair_coeff * * file " + coefffile);
+  else
+    lmp->input->one("pair_coeff * * " + std::to_string(EPS_REP) + " " + std::to_string(SIGMA_REP));
+  lmp->input->one("timestep 10.0");
+  lmp->input->one("thermo 0");
+  if (respa) lmp->input->one("run_style respa 3 2 2 bond 1 inner 1 5.0 6.0 middle 2 9.0 10.0 outer 3");
+  lmp->input->one("run 0");
+}
+
+static void run_case(LAMMPS *lmp, const std::string &style, const std::string &datafile,
+                     const std::string &coefffile, int nrep, int nsteps, Timing &t)
+{
+  Pair *pair;
+  double t0;
+
+  setup_system(lmp, style, datafile, coefffile, false);
+  pair = lmp->force->pair;
+
+  // listed pairs of the half neighbor list
+
+  NeighList *list = pair->list;
+  double mypairs = 0.0;
+  for (int ii = 0; ii < list->inum; ii++) mypairs += list->numneigh[list->ilist[ii]];
+  MPI_Allreduce(&mypairs, &t.npair, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  const double perpair = 1.0e9 / (nrep * t.npair);
+
+  t0 = walltime_sync();
+  for (int n = 0; n < nrep; n++) pair->compute(1, 0);
+  t.e_on = (walltime_sync() - t0) * perpair;
+
+  t0 = walltime_sync();
+  for (int n = 0; n < nrep; n++) pair->compute(0, 0);
+  t.e_off = (walltime_sync() - t0) * perpair;
+
+  // single() over all listed pairs inside the cutoff
+
+  double **x = lmp->atom->x;
+  int *type = lmp->atom->type;
+  double *special_lj = lmp->force->special_lj;
+  double esum = 0.0, fforce;
+  bigint ncall = 0;
+  t0 = walltime_sync();
+  for (int n = 0; n < nrep; n++)
+    for (int ii = 0; ii < list->inum; ii++) {
+      const int i = list->ilist[ii];
+      const int *jlist = list->firstneigh[i];
+      for (int jj = 0; jj < list->numneigh[i]; jj++) {
+        const int j = jlist[jj] & NEIGHMASK;
+        const double dx = x[i][0] - x[j][0], dy = x[i][1] - x[j][1], dz = x[i][2] - x[j][2];
+        const double rsq = dx * dx + dy * dy + dz * dz;
+        if (rsq >= pair->cutsq[type[i]][type[j]]) continue;
+        esum += pair->single(i, j, type[i], type[j], rsq, 1.0, special_lj[Pair::sbmask(jlist[jj])], fforce);
+        ncall++;
+      }
+    }
+  double dt = walltime_sync() - t0;
+  bigint ncall_all;
+  MPI_Allreduce(&ncall, &ncall_all, 1, MPI_LMP_BIGINT, MPI_SUM, MPI_COMM_WORLD);
+  t.single = (ncall_all && pair->single_enable) ? 1.0e9 * dt / ncall_all : 0.0;
+  if (esum == 12345.6789) printf(" ");    // keep the single() loop alive
+
+  t0 = walltime_sync();
+  for (int n = 0; n < nrep; n++) lmp->neighbor->build(1);
+  t.neigh = (walltime_sync() - t0) * 1.0e3 / nrep;
+
+  lmp->input->one("velocity all create 300.0 4928459 dist gaussian");
+  lmp->input->one("fix 1 all nve");
+  lmp->input->one("fix 2 all langevin 300.0 300.0 1000.0 48279");
+  lmp->input->one("run 0 post no");
+  t0 = walltime_sync();
+  lmp->input->one("run " + std::to_string(nsteps) + " pre no post no");
+  t.steps = nsteps / (walltime_sync() - t0);
+
+  // rRESPA levels, for styles that support them
+
+  t.inner = t.middle = t.outer = 0.0;
+  if (!pair->respa_enable) return;
+
+  setup_system(lmp, style, datafile, coefffile, true);
+  pair = lmp->force->pair;
+
+  t0 = walltime_sync();
+  for (int n = 0; n < nrep; n++) pair->compute_inner();
+  t.inner = (walltime_sync() - t0) * perpair;
+
+  t0 = walltime_sync();
+  for (int n = 0; n < nrep; n++) pair->compute_middle();
+  t.middle = (walltime_sync() - t0) * perpair;
+
+  t0 = walltime_sync();
+  for (int n = 0; n < nrep; n++) pair->compute_outer(1, 0);
+  t.outer = (walltime_sync() - t0) * perpair;
+}
+
+/* ---------------------------------------------------------------------- */
+
+static std::vector<std::string> split(const std::string &text, char sep)
+{
+  std::vector<std::string> items;
+  std::string item;
+  std::istringstream in(text);
+  while (std::getline(in, item, sep))
+    if (!item.empty()) items.push_back(item);
+  return items;
+}
+
+int main(int argc, char **argv)
+{
+  MPI_Init(&argc, &argv);
+  int me;
+  MPI_Comm_rank(MPI_COMM_WORLD, &me);
+
+  std::vector<int> sizes = {56, 560, 5600, 56000, 100000};
+  std::vector<std::string> styles = {"lj/cut", "lj/eten", "lj/eten/opt"};
+  int nrep = 100, nsteps = 1000;
+  unsigned seed = 12345;
+  std::string lmpflags;
+
+  for (int iarg = 1; iarg < argc; iarg++) {
+    if (iarg + 1 >= argc) {
+      if (me == 0) fprintf(stderr, "Missing value for %s\n", argv[iarg]);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    if (strcmp(argv[iarg], "-sizes") == 0) {
+      sizes.clear();
+      for (auto &s : split(argv[++iarg], ',')) sizes.push_back(std::stoi(s));
+    } else if (strcmp(argv[iarg], "-styles") == 0)
+      styles = split(argv[++iarg], ';');
+    else if (strcmp(argv[iarg], "-nrep") == 0)
+      nrep = std::stoi(argv[++iarg]);
+    else if (strcmp(argv[iarg], "-nsteps") == 0)
+      nsteps = std::stoi(argv[++iarg]);
+    else if (strcmp(argv[iarg], "-seed") == 0)
+      seed = std::stoul(argv[++iarg]);
+    else if (strcmp(argv[iarg], "-lmp") == 0)
+      lmpflags = argv[++iarg];
+    else {
+      if (me == 0) fprintf(stderr, "Unknown option %s\n", argv[iarg]);
+      MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+  }
+
+  std::vector<std::string> lmpargs = {"bench_lj_eten", "-log", "none", "-screen", "none", "-nocite"};
+  for (auto &flag : split(lmpflags, ' ')) lmpargs.push_back(flag);
+  std::vector<char *> lmpargv;
+  for (auto &arg : lmpargs) lmpargv.push_back(const_cast<char *>(arg.c_str()));
+  auto lmp = new LAMMPS(lmpargv.size(), lmpargv.data(), MPI_COMM_WORLD);
+
+  if (me == 0) {
+    printf("# %-28s %8s %10s %9s %9s %9s %9s %9s %9s %9s %9s\n", "style", "natoms", "pairs", "e_on",
+           "e_off", "inner", "middle", "outer", "single", "neigh", "steps/s");
+    printf("# %-28s %8s %10s %9s %9s %9s %9s %9s %9s %9s %9s\n", "", "", "", "ns/pair", "ns/pair",
+           "ns/pair", "ns/pair", "ns/pair", "ns/call", "ms", "");
+  }
+
+  for (int size : sizes) {
+    const int nchain = (size + NBEAD - 1) / NBEAD;
+    const std::string datafile = "bench_lj_eten_" + std::to_string(nchain) + ".data";
+    const std::string coefffile = "bench_lj_eten_" + std::to_string(nchain) + ".coeff";
+    if (me == 0) write_system(datafile, coefffile, nchain, seed);
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    for (auto &style : styles) {
+      Timing t;
+      run_case(lmp, style, datafile, coefffile, nrep, nsteps, t);
+      if (me == 0) {
+        printf("  %-28s %8d %10.0f %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f %9.1f\n", style.c_str(),
+               nchain * NBEAD, t.npair, t.e_on, t.e_off, t.inner, t.middle, t.outer, t.single, t.neigh,
+               t.steps);
+        fflush(stdout);
+      }
+    }
+  }
+
+  delete lmp;
+  MPI_Finalize();
+  return 0;
+}
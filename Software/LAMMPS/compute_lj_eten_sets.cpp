@@ -0,0 +1,156 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   lj/eten energy of the current configuration under K alternative
+   coefficient sets, evaluated in one sweep over the pairs of pair style
+   lj/eten, for reweighting and Hamiltonian replica exchange:
+
+     compute ID group-ID lj/eten/sets set1 set2 ...
+       set = file <name> [<escale> <dscale>]   coefficients from a
+                                               pair_coeff * * file,
+                                               others unchanged
+             scale <sa> <sb> <sc>              current A, B, C scaled
+
+   like compute pair the group is ignored.
+------------------------------------------------------------------------- */
+
+#include "compute_lj_eten_sets.h"
+
+#include "atom.h"
+#include "error.h"
+#include "force.h"
+#include "memory.h"
+#include "update.h"
+
+#include <cstring>
+#include <vector>
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+ComputeLJETENSets::ComputeLJETENSets(LAMMPS *lmp, int narg, char **arg) :
+    Compute(lmp, narg, arg), pair(nullptr), coeff(nullptr), scale(nullptr), table(nullptr),
+    one(nullptr)
+{
+  if (narg < 4) error->all(FLERR, "Illegal compute lj/eten/sets command");
+
+  pair = find_pair();
+  if (!pair) error->all(FLERR, "Compute lj/eten/sets requires pair style lj/eten");
+  if (!pair->energy_sets_supported())
+    error->all(FLERR, "Compute lj/eten/sets does not support pair style {} or lj/eten keywords residue or sparse",
+               force->pair_style);
+
+  ntypes = atom->ntypes;
+  const int ncoeff = PairLJETEN::COEFF_PER_PAIR * ntypes * (ntypes + 1) / 2;
+
+  // count sets first, so the per set arrays are allocated once
+
+  nset = 0;
+  for (int iarg = 3; iarg < narg; iarg++)
+    if ((strcmp(arg[iarg], "file") == 0) || (strcmp(arg[iarg], "scale") == 0)) nset++;
+  coeff = new double *[nset];
+  memory->create(scale, nset, 3, "lj/eten/sets:scale");
+
+  int iarg = 3;
+  for (int s = 0; s < nset; s++) {
+    coeff[s] = nullptr;
+    scale[s][0] = scale[s][1] = scale[s][2] = 1.0;
+
+    if (strcmp(arg[iarg], "file") == 0) {
+      if (iarg + 2 > narg) error->all(FLERR, "Illegal compute lj/eten/sets command");
+      double escale = 1.0, dscale = 1.0;
+      const char *file = arg[iarg + 1];
+      iarg += 2;
+      if ((iarg + 2 <= narg) && utils::is_double(arg[iarg]) && utils::is_double(arg[iarg + 1])) {
+        escale = utils::numeric(FLERR, arg[iarg], false, lmp);
+        dscale = utils::numeric(FLERR, arg[iarg + 1], false, lmp);
+        iarg += 2;
+      }
+      std::vector<double> records;
+      memory->create(coeff[s], ncoeff, "lj/eten/sets:coeff");
+      pair->load_coeff_file(file, escale, dscale, coeff[s], records);
+    } else if (strcmp(arg[iarg], "scale") == 0) {
+      if (iarg + 4 > narg) error->all(FLERR, "Illegal compute lj/eten/sets command");
+      for (int k = 0; k < 3; k++) scale[s][k] = utils::numeric(FLERR, arg[iarg + 1 + k], false, lmp);
+      iarg += 4;
+    } else
+      error->all(FLERR, "Unknown compute lj/eten/sets keyword: {}", arg[iarg]);
+  }
+  if (iarg < narg) error->all(FLERR, "Unknown compute lj/eten/sets keyword: {}", arg[iarg]);
+
+  vector_flag = 1;
+  size_vector = nset;
+  extvector = 1;
+
+  memory->create(table, ntypes + 1, (ntypes + 1) * nset, "lj/eten/sets:table");
+  memory->create(one, nset, "lj/eten/sets:one");
+  memory->create(vector, nset, "lj/eten/sets:vector");
+}
+
+/* ---------------------------------------------------------------------- */
+
+ComputeLJETENSets::~ComputeLJETENSets()
+{
+  if (coeff)
+    for (int s = 0; s < nset; s++) memory->destroy(coeff[s]);
+  delete[] coeff;
+  memory->destroy(scale);
+  memory->destroy(table);
+  memory->destroy(one);
+  memory->destroy(vector);
+}
+
+/* ---------------------------------------------------------------------- */
+
+PairLJETEN *ComputeLJETENSets::find_pair()
+{
+  return dynamic_cast<PairLJETEN *>(force->pair_match("^lj/eten", 0));
+}
+
+/* ---------------------------------------------------------------------- */
+
+void ComputeLJETENSets::init()
+{
+  pair = find_pair();
+  if (!pair) error->all(FLERR, "Compute lj/eten/sets requires pair style lj/eten");
+  if (!pair->energy_sets_supported())
+    error->all(FLERR, "Compute lj/eten/sets does not support pair style {} or lj/eten keywords residue or sparse",
+               force->pair_style);
+  if (atom->ntypes != ntypes) error->all(FLERR, "Compute lj/eten/sets number of atom types changed");
+}
+
+/* ----------------------------------------------------------------------
+   the tables are derived on every call, so that they follow changes of
+   the current coefficients, e.g. by fix adapt
+------------------------------------------------------------------------- */
+
+void ComputeLJETENSets::compute_vector()
+{
+  invoked_vector = update->ntimestep;
+
+  for (int s = 0; s < nset; s++) pair->energy_set_params(coeff[s], scale[s], nset, s, table);
+  pair->compute_energy_sets(nset, table, one);
+  MPI_Allreduce(one, vector, nset, MPI_DOUBLE, MPI_SUM, world);
+}
+
+/* ---------------------------------------------------------------------- */
+
+double ComputeLJETENSets::memory_usage()
+{
+  double bytes = (double) (ntypes + 1) * (ntypes + 1) * nset * sizeof(PairLJETEN::Param);
+  for (int s = 0; s < nset; s++)
+    if (coeff[s]) bytes += (double) PairLJETEN::COEFF_PER_PAIR * ntypes * (ntypes + 1) / 2 * sizeof(double);
+  return bytes;
+}
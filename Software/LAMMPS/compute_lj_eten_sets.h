@@ -0,0 +1,51 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef COMPUTE_CLASS
+// clang-format off
+ComputeStyle(lj/eten/sets,ComputeLJETENSets);
+// clang-format on
+#else
+
+#ifndef LMP_COMPUTE_LJ_ETEN_SETS_H
+#define LMP_COMPUTE_LJ_ETEN_SETS_H
+
+#include "compute.h"
+#include "pair_lj_eten.h"
+
+namespace LAMMPS_NS {
+
+class ComputeLJETENSets : public Compute {
+ public:
+  ComputeLJETENSets(class LAMMPS *, int, char **);
+  ~ComputeLJETENSets() override;
+  void init() override;
+  void compute_vector() override;
+  double memory_usage() override;
+
+ protected:
+  class PairLJETEN *pair;
+  int nset;
+  int ntypes;
+  double **coeff;     // dense coefficient buffer of each set, null for scale only sets
+  double **scale;     // A, B, C factors of each set
+  PairLJETEN::Param **table;
+  double *one;
+
+  class PairLJETEN *find_pair();
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
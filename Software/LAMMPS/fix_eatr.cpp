@@ -0,0 +1,402 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   Streams the metadynamics bias V(t) of one trajectory into the running
+   acceleration integrals int exp(beta gamma V(t)) dt used by the EATR
+   estimator of Software/rate_analysis, and records the first passage
+   time, so no colvar file needs to be kept for the rate analysis.
+   The optional bias history V(t) on the common sample grid feeds the
+   trajectory averaged acceleration of EATR_MLE_rate() and EATR_CDF_rate()
+   through load_eatr() in rate_methods.py.
+------------------------------------------------------------------------- */
+
+#include "fix_eatr.h"
+
+#include "arg_info.h"
+#include "comm.h"
+#include "compute.h"
+#include "error.h"
+#include "force.h"
+#include "input.h"
+#include "modify.h"
+#include "timer.h"
+#include "update.h"
+#include "variable.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+static constexpr double LOG_ZERO = -std::numeric_limits<double>::infinity();
+
+/* ----------------------------------------------------------------------
+   log(exp(a) + exp(b)) without overflow
+------------------------------------------------------------------------- */
+
+static inline double logaddexp(double a, double b)
+{
+  if (a == LOG_ZERO) return b;
+  if (b == LOG_ZERO) return a;
+  return (a > b) ? a + log1p(exp(b - a)) : b + log1p(exp(a - b));
+}
+
+/* ---------------------------------------------------------------------- */
+
+FixEATR::FixEATR(LAMMPS *lmp, int narg, char **arg) :
+    Fix(lmp, narg, arg), id_bias(nullptr), cbias(nullptr), fbias(nullptr), id_event(nullptr),
+    file(nullptr), file_history(nullptr), fp_history(nullptr)
+{
+  if (narg < 7) error->all(FLERR, "Illegal fix eatr command");
+
+  nevery = utils::inumeric(FLERR, arg[3], false, lmp);
+  if (nevery <= 0) error->all(FLERR, "Illegal fix eatr nevery value: {}", nevery);
+
+  ArgInfo argi(arg[4]);
+  which = argi.get_type();
+  if (((which != ArgInfo::COMPUTE) && (which != ArgInfo::FIX) && (which != ArgInfo::VARIABLE)) ||
+      (argi.get_dim() != 0))
+    error->all(FLERR, "Illegal fix eatr bias argument: {}", arg[4]);
+  id_bias = argi.copy_name();
+
+  if (strcmp(arg[5], "temp") != 0) error->all(FLERR, "Illegal fix eatr command: expected temp keyword");
+  double temperature = utils::numeric(FLERR, arg[6], false, lmp);
+  if (temperature <= 0.0) error->all(FLERR, "Illegal fix eatr temp value: {}", temperature);
+  beta = 1.0 / (force->boltz * temperature);
+
+  stopflag = 1;
+  label = id;
+
+  int iarg = 7;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg], "gamma") == 0) {
+      if (iarg + 2 > narg) error->all(FLERR, "Illegal fix eatr command");
+      int n = utils::inumeric(FLERR, arg[iarg + 1], false, lmp);
+      if (n <= 0 || iarg + 2 + n > narg) error->all(FLERR, "Illegal fix eatr gamma values");
+      gamma.clear();
+      for (int k = 0; k < n; k++) gamma.push_back(utils::numeric(FLERR, arg[iarg + 2 + k], false, lmp));
+      iarg += 2 + n;
+    } else if (strcmp(arg[iarg], "event") == 0) {
+      if (iarg + 2 > narg) error->all(FLERR, "Illegal fix eatr command");
+      if (!utils::strmatch(arg[iarg + 1], "^v_"))
+        error->all(FLERR, "Fix eatr event must be an equal-style variable v_name");
+      delete[] id_event;
+      id_event = utils::strdup(arg[iarg + 1] + 2);
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "stop") == 0) {
+      if (iarg + 2 > narg) error->all(FLERR, "Illegal fix eatr command");
+      stopflag = utils::logical(FLERR, arg[iarg + 1], false, lmp);
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "file") == 0) {
+      if (iarg + 2 > narg) error->all(FLERR, "Illegal fix eatr command");
+      delete[] file;
+      file = utils::strdup(arg[iarg + 1]);
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "history") == 0) {
+      if (iarg + 2 > narg) error->all(FLERR, "Illegal fix eatr command");
+      delete[] file_history;
+      file_history = utils::strdup(arg[iarg + 1]);
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "label") == 0) {
+      if (iarg + 2 > narg) error->all(FLERR, "Illegal fix eatr command");
+      label = arg[iarg + 1];
+      iarg += 2;
+    } else
+      error->all(FLERR, "Unknown fix eatr keyword: {}", arg[iarg]);
+  }
+  if (gamma.empty()) gamma.push_back(1.0);
+
+  vector_flag = 1;
+  size_vector = 4 + gamma.size();
+  global_freq = nevery;
+  extvector = 0;
+  restart_global = 1;
+
+  start_trajectory();
+}
+
+/* ---------------------------------------------------------------------- */
+
+FixEATR::~FixEATR()
+{
+  // a trajectory without event is recorded as censored at its end
+
+  if (!written && nsample) write_record();
+
+  if (fp_history) fclose(fp_history);
+  delete[] id_bias;
+  delete[] id_event;
+  delete[] file;
+  delete[] file_history;
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixEATR::setmask()
+{
+  int mask = 0;
+  mask |= END_OF_STEP;
+  return mask;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixEATR::init()
+{
+  cbias = nullptr;
+  fbias = nullptr;
+  ivar_bias = ivar_event = -1;
+
+  if (which == ArgInfo::COMPUTE) {
+    cbias = modify->get_compute_by_id(id_bias);
+    if (!cbias) error->all(FLERR, "Compute ID {} for fix eatr does not exist", id_bias);
+    if (!cbias->scalar_flag) error->all(FLERR, "Fix eatr compute {} does not calculate a scalar", id_bias);
+  } else if (which == ArgInfo::FIX) {
+    fbias = modify->get_fix_by_id(id_bias);
+    if (!fbias) error->all(FLERR, "Fix ID {} for fix eatr does not exist", id_bias);
+    if (!fbias->scalar_flag) error->all(FLERR, "Fix eatr fix {} does not calculate a scalar", id_bias);
+    if (nevery % fbias->global_freq)
+      error->all(FLERR, "Fix {} for fix eatr not computed at compatible time", id_bias);
+  } else {
+    ivar_bias = input->variable->find(id_bias);
+    if (ivar_bias < 0) error->all(FLERR, "Variable name {} for fix eatr does not exist", id_bias);
+    if (!input->variable->equalstyle(ivar_bias))
+      error->all(FLERR, "Fix eatr variable {} is not equal-style", id_bias);
+  }
+
+  if (id_event) {
+    ivar_event = input->variable->find(id_event);
+    if (ivar_event < 0) error->all(FLERR, "Variable name {} for fix eatr does not exist", id_event);
+    if (!input->variable->equalstyle(ivar_event))
+      error->all(FLERR, "Fix eatr variable {} is not equal-style", id_event);
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixEATR::setup(int /*vflag*/)
+{
+  if (cbias) modify->addstep_compute((update->ntimestep / nevery) * nevery + nevery);
+}
+
+/* ----------------------------------------------------------------------
+   add one bias sample, each sample stands for nevery timesteps
+------------------------------------------------------------------------- */
+
+void FixEATR::end_of_step()
+{
+  if (done) return;
+
+  double bias;
+  modify->clearstep_compute();
+  if (cbias) {
+    if (!(cbias->invoked_flag & Compute::INVOKED_SCALAR)) {
+      cbias->compute_scalar();
+      cbias->invoked_flag |= Compute::INVOKED_SCALAR;
+    }
+    bias = cbias->scalar;
+  } else if (fbias)
+    bias = fbias->compute_scalar();
+  else
+    bias = input->variable->compute_equal(ivar_bias);
+  if (file_history) write_history(bias);
+
+  const double logdt = log(nevery * update->dt);
+  for (std::size_t k = 0; k < gamma.size(); k++)
+    logacc[k] = logaddexp(logacc[k], beta * gamma[k] * bias + logdt);
+  vmax = (nsample == 0) ? bias : MAX(vmax, bias);
+  vsum += bias;
+  nsample++;
+  tfpt = elapsed();
+
+  if (ivar_event >= 0 && input->variable->compute_equal(ivar_event) != 0.0) {
+    event = done = 1;
+    write_record();
+    if (stopflag) timer->force_timeout();
+  }
+
+  if (cbias && !done) modify->addstep_compute(update->ntimestep + nevery);
+}
+
+/* ----------------------------------------------------------------------
+   fix_modify reset [label name]: record the current trajectory and start
+   a new one at the current timestep, for replicas run one after the
+   other in the same LAMMPS instance
+------------------------------------------------------------------------- */
+
+int FixEATR::modify_param(int narg, char **arg)
+{
+  if (strcmp(arg[0], "reset") != 0) return 0;
+
+  if (!written && nsample) write_record();
+  int n = 1;
+  if ((narg >= 3) && (strcmp(arg[1], "label") == 0)) {
+    label = arg[2];
+    n = 3;
+  }
+  start_trajectory();
+  return n;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixEATR::start_trajectory()
+{
+  // a continued run writes the record and history of a trajectory again,
+  // rate_methods.py keeps the last version per id
+
+  uid = 0;
+  if (comm->me == 0) {
+    std::random_device rd;
+    uid = ((((bigint) rd()) << 21) ^ rd()) & ((((bigint) 1) << 53) - 1);
+  }
+  MPI_Bcast(&uid, 1, MPI_LMP_BIGINT, 0, world);
+
+  step0 = update->ntimestep;
+  nsample = 0;
+  event = done = written = 0;
+  tfpt = 0.0;
+  vmax = LOG_ZERO;
+  vsum = 0.0;
+  logacc.assign(gamma.size(), LOG_ZERO);
+}
+
+/* ---------------------------------------------------------------------- */
+
+double FixEATR::elapsed() const
+{
+  return (update->ntimestep - step0) * update->dt;
+}
+
+/* ----------------------------------------------------------------------
+   0 = first passage or elapsed time, 1 = event flag, 2 = max bias,
+   3 = mean bias, 4+k = log of the acceleration integral for gamma k
+------------------------------------------------------------------------- */
+
+double FixEATR::compute_vector(int n)
+{
+  if (n == 0) return tfpt;
+  if (n == 1) return event;
+  if (n == 2) return nsample ? vmax : 0.0;
+  if (n == 3) return nsample ? vsum / nsample : 0.0;
+  return logacc[n - 4];
+}
+
+/* ----------------------------------------------------------------------
+   append the one line record of this trajectory, with a header line
+   when the file is new
+------------------------------------------------------------------------- */
+
+void FixEATR::write_record()
+{
+  written = 1;
+  if (comm->me != 0) return;
+  if (fp_history) fflush(fp_history);
+
+  std::string record = fmt::format("{} {} {:.10g} {} {} {:.10g} {:.10g}", label, uid, tfpt, event, nsample,
+                                   nsample ? vmax : 0.0, nsample ? vsum / nsample : 0.0);
+  for (double acc : logacc) record += fmt::format(" {:.12g}", acc);
+  record += "\n";
+
+  if (!file) {
+    utils::logmesg(lmp, "fix eatr {}: {}", id, record);
+    return;
+  }
+
+  FILE *fp = fopen(file, "a");
+  if (!fp) {
+    error->warning(FLERR, "Cannot open fix eatr file {}: {}", file, utils::getsyserror());
+    return;
+  }
+  if (ftell(fp) == 0) {
+    std::string header = "# label id time event nsample vmax vmean";
+    for (double g : gamma) header += fmt::format(" logacc(gamma={})", g);
+    fmt::print(fp, "{}\n", header);
+  }
+  fputs(record.c_str(), fp);
+  fclose(fp);
+}
+
+/* ----------------------------------------------------------------------
+   append one bias sample to the history file, led by a "# trajectory"
+   line with label and id at the first sample of each trajectory and
+   when a continued run reopens the file
+------------------------------------------------------------------------- */
+
+void FixEATR::write_history(double bias)
+{
+  if (comm->me != 0) return;
+
+  int lead = (nsample == 0);
+  if (!fp_history) {
+    fp_history = fopen(file_history, "a");
+    if (!fp_history)
+      error->one(FLERR, "Cannot open fix eatr history file {}: {}", file_history, utils::getsyserror());
+    if (ftell(fp_history) == 0) fmt::print(fp_history, "# time bias\n");
+    lead = 1;
+  }
+  if (lead) fmt::print(fp_history, "# trajectory {} {}\n", label, uid);
+  fmt::print(fp_history, "{:.10g} {:.10g}\n", (update->ntimestep - step0) * update->dt, bias);
+}
+
+/* ----------------------------------------------------------------------
+   pack running integrals of the trajectory into restart file
+------------------------------------------------------------------------- */
+
+void FixEATR::write_restart(FILE *fp)
+{
+  std::vector<double> list;
+  list.push_back(gamma.size());
+  list.push_back(step0);
+  list.push_back(nsample);
+  list.push_back(event);
+  list.push_back(done);
+  list.push_back(written);
+  list.push_back(tfpt);
+  list.push_back(vmax);
+  list.push_back(vsum);
+  list.insert(list.end(), logacc.begin(), logacc.end());
+  list.push_back(uid);
+
+  if (comm->me == 0) {
+    int size = list.size() * sizeof(double);
+    fwrite(&size, sizeof(int), 1, fp);
+    fwrite(list.data(), sizeof(double), list.size(), fp);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   use state info from restart file to continue the trajectory
+------------------------------------------------------------------------- */
+
+void FixEATR::restart(char *buf)
+{
+  auto list = (double *) buf;
+  if ((std::size_t) list[0] != gamma.size())
+    error->all(FLERR, "Fix eatr gamma values do not match the restart file");
+
+  step0 = (bigint) list[1];
+  nsample = (bigint) list[2];
+  event = (int) list[3];
+  done = (int) list[4];
+  written = (int) list[5];
+  tfpt = list[6];
+  vmax = list[7];
+  vsum = list[8];
+  for (std::size_t k = 0; k < gamma.size(); k++) logacc[k] = list[9 + k];
+  uid = (bigint) list[9 + gamma.size()];
+}
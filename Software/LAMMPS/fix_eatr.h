@@ -0,0 +1,82 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef FIX_CLASS
+// clang-format off
+FixStyle(eatr,FixEATR);
+// clang-format on
+#else
+
+#ifndef LMP_FIX_EATR_H
+#define LMP_FIX_EATR_H
+
+#include "fix.h"
+
+#include <string>
+#include <vector>
+
+namespace LAMMPS_NS {
+
+class FixEATR : public Fix {
+ public:
+  FixEATR(class LAMMPS *, int, char **);
+  ~FixEATR() override;
+  int setmask() override;
+  void init() override;
+  void setup(int) override;
+  void end_of_step() override;
+  double compute_vector(int) override;
+  int modify_param(int, char **) override;
+  void write_restart(FILE *) override;
+  void restart(char *) override;
+
+ protected:
+  // bias source: a global scalar of a compute or fix, or an equal-style variable
+
+  int which;
+  char *id_bias;
+  class Compute *cbias;
+  class Fix *fbias;
+  int ivar_bias;
+
+  char *id_event;    // equal-style variable, nonzero once the trajectory committed
+  int ivar_event;
+  int stopflag;
+  char *file;
+  char *file_history;    // per sample bias V(t), one block per trajectory
+  FILE *fp_history;
+  std::string label;
+
+  double beta;
+  std::vector<double> gamma;
+
+  // running state of the trajectory, kept in the restart file
+
+  bigint step0;        // timestep the trajectory started at
+  bigint uid;          // random id, keys records and history blocks across restarts
+  bigint nsample;
+  int event, done, written;
+  double tfpt;         // first passage time, or elapsed time without event
+  double vmax, vsum;
+  std::vector<double> logacc;    // log of int exp(beta gamma_k V(t)) dt
+
+  void start_trajectory();
+  double elapsed() const;
+  void write_record();
+  void write_history(double);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
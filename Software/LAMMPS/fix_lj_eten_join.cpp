@@ -0,0 +1,91 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   Internal fix of pair style lj/eten keyword async. It arms the pair
+   style before the force computation of an MD step and, as the last
+   post_force fix, waits for the worker thread and adds its forces, so
+   that fixes like plumed overlap with the pair kernel. Fixes before it
+   see atom->f without the lj/eten forces, so fixes that overwrite or
+   project atom->f in post_force are rejected.
+------------------------------------------------------------------------- */
+
+#include "fix_lj_eten_join.h"
+
+#include "error.h"
+#include "force.h"
+#include "modify.h"
+#include "pair_lj_eten.h"
+
+using namespace LAMMPS_NS;
+using namespace FixConst;
+
+/* ---------------------------------------------------------------------- */
+
+FixLJETENJoin::FixLJETENJoin(LAMMPS *lmp, int narg, char **arg) :
+    Fix(lmp, narg, arg), pair(nullptr)
+{
+  if (narg != 3) error->all(FLERR, "Illegal fix LJ_ETEN_JOIN command");
+}
+
+/* ---------------------------------------------------------------------- */
+
+int FixLJETENJoin::setmask()
+{
+  int mask = 0;
+  mask |= PRE_FORCE;
+  mask |= POST_FORCE;
+  return mask;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixLJETENJoin::init()
+{
+  pair = dynamic_cast<PairLJETEN *>(force->pair);
+  if (!pair) error->all(FLERR, "Fix LJ_ETEN_JOIN requires pair style lj/eten");
+
+  static const char *exclusive[] = {"setforce", "aveforce", "freeze", "lineforce", "planeforce",
+                                    "enforce2d"};
+  for (const char *style : exclusive)
+    if (!modify->get_fix_by_style(fmt::format("^{}", style)).empty())
+      error->all(FLERR, "Pair style lj/eten keyword async cannot be used with fix {}", style);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixLJETENJoin::setup_pre_force(int /*vflag*/)
+{
+  pair->async_arm();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixLJETENJoin::setup(int /*vflag*/)
+{
+  pair->async_join();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixLJETENJoin::pre_force(int /*vflag*/)
+{
+  pair->async_arm();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void FixLJETENJoin::post_force(int /*vflag*/)
+{
+  pair->async_join();
+}
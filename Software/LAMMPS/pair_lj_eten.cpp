@@ -16,24 +16,62 @@
 ------------------------------------------------------------------------- */
 
 #include "pair_lj_eten.h"
+#include "pair_lj_eten_kernel.h"
 
 #include "atom.h"
 #include "comm.h"
+#include "domain.h"
 #include "error.h"
 #include "force.h"
 #include "math_const.h"
 #include "memory.h"
+#include "modify.h"
 #include "neigh_list.h"
 #include "neighbor.h"
+#include "platform.h"
 #include "respa.h"
 #include "update.h"
 
+#include <array>
 #include <cmath>
+#include <condition_variable>
 #include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 using namespace LAMMPS_NS;
+using namespace LJETEN;
 using namespace MathConst;
 
+enum { TALLY_NONE, TALLY_SUM, TALLY_PAIR };
+enum { ASYNC_IDLE, ASYNC_QUEUED, ASYNC_DONE, ASYNC_QUIT };
+
+static constexpr int MAXLINE = 1024;
+static constexpr int DELTA_OVERRIDE = 1024;
+static constexpr int DELTA_COMPACT = 1024;
+static constexpr char LJETEN_MAGIC[] = "LJETEN01";
+
+// layout of the restart settings and coefficients, to be incremented
+// with every change of what write_restart() writes
+
+static constexpr int LJETEN_RESTART_VERSION = 1;
+static const std::string ASYNC_FIX_ID = "LJ_ETEN_JOIN";
+
+// worker thread of async mode. the main thread queues a task, the
+// worker runs it and marks it done, the main thread joins it.
+
+struct PairLJETEN::AsyncWorker {
+  std::thread thread;
+  std::mutex mutex;
+  std::condition_variable cv;
+  int state = ASYNC_IDLE;
+};
+
 /* ---------------------------------------------------------------------- */
 
 PairLJETEN::PairLJETEN(LAMMPS *lmp) : Pair(lmp)
@@ -41,6 +79,92 @@ PairLJETEN::PairLJETEN(LAMMPS *lmp) : Pair(lmp)
   respa_enable = 1;
   born_matrix_enable = 1;
   writedata = 1;
+
+  cut = cut_eval = nullptr;
+  aterm = bterm = cterm = nullptr;
+  params = nullptr;
+  cut_respa = nullptr;
+
+  allpairs_flag = 0;
+  npair_all = 0;
+  isolated_flag = 0;
+  allpairs_stale = 1;
+  allpairs = nullptr;
+
+  native_flag = 0;
+  cut_repulsive = native_emin = 0.0;
+  native = nullptr;
+  nnative = nnative_local = 0;
+  native_tags = nullptr;
+  native_stale = 1;
+  native_list = nullptr;
+
+  q_flag = qderiv_flag = 0;
+  q_beta = q_lambda = 0.0;
+  ncontact = 0;
+  contact_tags = nullptr;
+  contact_ref = contact_weight = nullptr;
+  native_qref = native_qweight = nullptr;
+  qnative = 0.0;
+  q_request = qderiv_request = 0;
+  nmax_qderiv = 0;
+  qderiv = nullptr;
+  nextra = 0;
+  pvector = nullptr;
+
+  cut_tolerance = 0.0;
+  tol_pending = 0;
+
+  residue_flag = 0;
+  residue_name = nullptr;
+  residue_index = -1;
+  nresidue = 0;
+  res_coeff = nullptr;
+  res_params = nullptr;
+  res_cutmax = 0.0;
+
+  sparse_flag = 0;
+  sparse_a = sparse_cut = 0.0;
+  noverride = maxoverride = 0;
+  overrides = nullptr;
+  sparse_first = nullptr;
+  sparse_jtype = nullptr;
+  sparse_params = nullptr;
+
+  scale_in_kernel = 1;
+  scale_global = scale_kernel = scale_param = 1.0;
+  coeff_init = nullptr;
+  reinit_partial = 0;
+
+  stats_flag = 0;
+  stats_reset();
+  for (double &v : stats) v = 0.0;
+
+  fdotr_forced = fdotr_saved = 0;
+
+  async_flag = 0;
+  async_armed = async_pending = 0;
+  async = new AsyncWorker;
+  nmax_async = 0;
+  f_async = nullptr;
+
+  table_bits = 0;
+  table_inner = table_innersq = 0.0;
+  table_stale = 1;
+  table_report = 0;
+  table_shift = table_base = 0;
+  table_offset = nullptr;
+  table_segs = nullptr;
+
+  compact_flag = 0;
+  compact_stale = 1;
+  compact_short = 0;
+  max_compact_first = max_compact = max_compact_special = 0;
+  ncompact_special = 0;
+  compact_first = nullptr;
+  compact_j16 = nullptr;
+  compact_j32 = nullptr;
+  compact_special = nullptr;
 }
 
 /* ---------------------------------------------------------------------- */
@@ -49,43 +173,1289 @@ PairLJETEN::~PairLJETEN()
 {
   if (copymode) return;
 
-  if (allocated) {
-    memory->destroy(setflag);
-    memory->destroy(cutsq);
+  async_stop();
+  delete async;
+  memory->destroy(f_async);
+  if (modify->get_fix_by_id(ASYNC_FIX_ID)) modify->delete_fix(ASYNC_FIX_ID);
+  memory->destroy(table_offset);
+  memory->sfree(table_segs);
+  memory->destroy(compact_first);
+  memory->destroy(compact_j16);
+  memory->destroy(compact_j32);
+  memory->sfree(compact_special);
+
+  memory->sfree(allpairs);
+  memory->destroy(native_tags);
+  memory->sfree(native_list);
+  memory->destroy(contact_tags);
+  memory->destroy(contact_ref);
+  memory->destroy(contact_weight);
+  memory->destroy(native_qref);
+  memory->destroy(native_qweight);
+  memory->destroy(qderiv);
+  delete[] pvector;
+  delete[] residue_name;
+  memory->destroy(res_coeff);
+  memory->destroy(res_params);
+  memory->sfree(overrides);
+  memory->destroy(sparse_first);
+  memory->destroy(sparse_jtype);
+  memory->sfree(sparse_params);
+
+  if (allocated) deallocate();
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairLJETEN::compute(int eflag, int vflag)
+{
+  if (async_pending) async_join();
+  if (async_armed) {
+    async_armed = 0;
+    if (async_launch(eflag, vflag)) return;
+  }
 
-    memory->destroy(cut);
-    memory->destroy(aterm);
-    memory->destroy(bterm);
-    memory->destroy(cterm);
-    memory->destroy(lj1);
-    memory->destroy(lj2);
-    memory->destroy(lj3);
-    memory->destroy(lj4);
-    memory->destroy(lj5);
-    memory->destroy(lj6);
-    memory->destroy(offset);
+  if (!stats_flag) {
+    eval<0>(eflag, vflag);
+    return;
   }
+
+  const double t0 = platform::walltime();
+  eval<1>(eflag, vflag);
+  stats_local[STAT_TIME] += platform::walltime() - t0;
+  stats_local[STAT_CALLS] += 1.0;
+  if (eflag_global) stats_reduce();
 }
 
 /* ---------------------------------------------------------------------- */
 
-void PairLJETEN::compute(int eflag, int vflag)
+template <int STATS> void PairLJETEN::eval(int eflag, int vflag)
+{
+  if (allpairs_flag) {
+    compute_allpairs(eflag, vflag);
+    return;
+  }
+  if (residue_flag) {
+    compute_residue<STATS>(eflag, vflag);
+    return;
+  }
+  if (sparse_flag) {
+    ev_init(eflag, vflag);
+    if (evflag) {
+      if (eflag) {
+        if (force->newton_pair) eval_sparse<1, 1, 1, STATS>();
+        else eval_sparse<1, 1, 0, STATS>();
+      } else {
+        if (force->newton_pair) eval_sparse<1, 0, 1, STATS>();
+        else eval_sparse<1, 0, 0, STATS>();
+      }
+    } else {
+      if (force->newton_pair) eval_sparse<0, 0, 1, STATS>();
+      else eval_sparse<0, 0, 0, STATS>();
+    }
+    if (vflag_fdotr) virial_fdotr_compute();
+    return;
+  }
+
+  ev_init(eflag, vflag);
+
+  if (table_bits) {
+    if (table_stale) table_setup();
+    eval_dense_tally<1, STATS>(atom->f);
+  } else if (compact_flag)
+    eval_compact_tally();
+  else
+    eval_dense_tally<0, STATS>(atom->f);
+
+  if (native_flag) compute_native(eflag);
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <int TABLE, int STATS> void PairLJETEN::eval_dense_tally(double **f)
+{
+  // global energy and virial are summed in the kernel itself,
+  // ev_tally() is only called for per-atom tallies
+
+  if (!evflag) eval_dense<TABLE, TALLY_NONE, 0, 0, STATS>(f);
+  else if (eflag_atom || vflag_atom || cvflag_atom)
+    eval_dense<TABLE, TALLY_PAIR, 0, 0, STATS>(f);
+  else if (eflag_global) {
+    if (vflag_global) eval_dense<TABLE, TALLY_SUM, 1, 1, STATS>(f);
+    else eval_dense<TABLE, TALLY_SUM, 1, 0, STATS>(f);
+  } else
+    eval_dense<TABLE, TALLY_SUM, 0, 1, STATS>(f);
+}
+
+/* ----------------------------------------------------------------------
+   neighbor list loop of the dense parameter tables. with TALLY_SUM the
+   global energy and virial are accumulated in locals and added once,
+   with TALLY_PAIR every pair goes through ev_tally(). forces go to f,
+   which is atom->f or the buffer of the async worker. with TABLE the
+   pair interaction is looked up in the spline tables of table_setup().
+------------------------------------------------------------------------- */
+
+template <int TABLE, int TALLY, int EFLAG, int VFLAG, int STATS>
+void PairLJETEN::eval_dense(double **f)
 {
   int i, j, ii, jj, inum, jnum, itype, jtype;
   double xtmp, ytmp, ztmp, delx, dely, delz, evdwl, fpair;
+  double rsq, r2inv, r6inv, forcelj, factor_lj, eone;
+  int *ilist, *jlist, *numneigh, **firstneigh;
+  Param *parami;
+  bigint nvisited = 0, ninside = 0, nspecial = 0;
+  double esum = 0.0;
+  double vsum[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+  evdwl = 0.0;
+
+  double **x = atom->x;
+  int *type = atom->type;
+  int nlocal = atom->nlocal;
+  union_int_float_t rsq_lookup;
+  int *tablei = nullptr;
+
+  // tables already contain the global scale
+
+  double special_lj[4];
+  if (TABLE) {
+    for (int k = 0; k < 4; k++) special_lj[k] = force->special_lj[k];
+  } else
+    scaled_special(special_lj);
+  int newton_pair = force->newton_pair;
+
+  inum = list->inum;
+  ilist = list->ilist;
+  numneigh = list->numneigh;
+  firstneigh = list->firstneigh;
+
+  // loop over neighbors of my atoms
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    xtmp = x[i][0];
+    ytmp = x[i][1];
+    ztmp = x[i][2];
+    itype = type[i];
+    parami = params[itype];
+    if (TABLE) tablei = table_offset[itype];
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+    if (STATS) nvisited += jnum;
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      factor_lj = special_lj[sbmask(j)];
+      j &= NEIGHMASK;
+
+      delx = xtmp - x[j][0];
+      dely = ytmp - x[j][1];
+      delz = ztmp - x[j][2];
+      rsq = delx * delx + dely * dely + delz * delz;
+      jtype = type[j];
+
+      if (rsq < parami[jtype].cutsq) {
+        if (STATS) {
+          ninside++;
+          if (factor_lj != 1.0) nspecial++;
+        }
+        if (TABLE) {
+
+          // below the table range single() is evaluated directly
+
+          if (rsq >= table_innersq) {
+            rsq_lookup.f = rsq;
+            const int k = (rsq_lookup.i >> table_shift) - table_base;
+            rsq_lookup.i = (k + table_base) << table_shift;
+            const double d = rsq - rsq_lookup.f;
+            const TableSeg &seg = table_segs[tablei[jtype] + k];
+            forcelj = seg.f0 + d * (seg.f1 + d * (seg.f2 + d * seg.f3));
+            eone = seg.e0 + d * (seg.e1 + d * (seg.e2 + d * seg.e3));
+          } else
+            eone = single(i, j, itype, jtype, rsq, 0.0, 1.0, forcelj);
+          fpair = factor_lj * forcelj;
+        } else {
+          r2inv = 1.0 / rsq;
+          r6inv = r2inv * r2inv * r2inv;
+          forcelj = r6inv * (parami[jtype].lj1 * r6inv - parami[jtype].lj2 * r2inv * r2inv + parami[jtype].lj3);
+          fpair = factor_lj * forcelj * r2inv;
+          if (EFLAG || (TALLY == TALLY_PAIR))
+            eone = r6inv * (parami[jtype].lj4 * r6inv - parami[jtype].lj5 * r2inv * r2inv + parami[jtype].lj6) - parami[jtype].offset;
+        }
+
+        f[i][0] += delx * fpair;
+        f[i][1] += dely * fpair;
+        f[i][2] += delz * fpair;
+        if (newton_pair || j < nlocal) {
+          f[j][0] -= delx * fpair;
+          f[j][1] -= dely * fpair;
+          f[j][2] -= delz * fpair;
+        }
+
+        if (TALLY == TALLY_PAIR) {
+          if (eflag_either) evdwl = factor_lj * eone;
+          ev_tally(i, j, nlocal, newton_pair, evdwl, 0.0, fpair, delx, dely, delz);
+        } else if (TALLY == TALLY_SUM) {
+
+          // a pair with a ghost atom counts half with newton off, as in ev_tally()
+
+          const double weight = (newton_pair || j < nlocal) ? 1.0 : 0.5;
+          if (EFLAG) esum += weight * factor_lj * eone;
+          if (VFLAG) {
+            const double wf = weight * fpair;
+            vsum[0] += wf * delx * delx;
+            vsum[1] += wf * dely * dely;
+            vsum[2] += wf * delz * delz;
+            vsum[3] += wf * delx * dely;
+            vsum[4] += wf * delx * delz;
+            vsum[5] += wf * dely * delz;
+          }
+        }
+      }
+    }
+  }
+
+  if (TALLY == TALLY_SUM) {
+    if (EFLAG) eng_vdwl += esum;
+    if (VFLAG)
+      for (int k = 0; k < 6; k++) virial[k] += vsum[k];
+  }
+
+  if (STATS) {
+    stats_local[STAT_VISITED] += nvisited;
+    stats_local[STAT_INSIDE] += ninside;
+    stats_local[STAT_SPECIAL] += nspecial;
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairLJETEN::compute_inner()
+{
+  if (!stats_flag) {
+    eval_respa<12, 10, 6, RESPA_INNER, 0, 0, 0, 0>();
+    return;
+  }
+
+  const double t0 = platform::walltime();
+  eval_respa<12, 10, 6, RESPA_INNER, 0, 0, 0, 0>();
+  stats_local[STAT_TIME_INNER] += platform::walltime() - t0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairLJETEN::compute_middle()
+{
+  if (!stats_flag) {
+    eval_respa<12, 10, 6, RESPA_MIDDLE, 0, 0, 0, 0>();
+    return;
+  }
+
+  const double t0 = platform::walltime();
+  eval_respa<12, 10, 6, RESPA_MIDDLE, 0, 0, 0, 0>();
+  stats_local[STAT_TIME_MIDDLE] += platform::walltime() - t0;
+}
+
+/* ----------------------------------------------------------------------
+   only the outer level, which loops over the full neighbor list,
+   contributes to the pair counts
+------------------------------------------------------------------------- */
+
+void PairLJETEN::compute_outer(int eflag, int vflag)
+{
+  ev_init(eflag, vflag);
+
+  if (!stats_flag) {
+    if (evflag) {
+      if (eflag_either) {
+        if (vflag_either) eval_respa<12, 10, 6, RESPA_OUTER, 1, 1, 1, 0>();
+        else eval_respa<12, 10, 6, RESPA_OUTER, 1, 1, 0, 0>();
+      } else {
+        if (vflag_either) eval_respa<12, 10, 6, RESPA_OUTER, 1, 0, 1, 0>();
+        else eval_respa<12, 10, 6, RESPA_OUTER, 1, 0, 0, 0>();
+      }
+    } else eval_respa<12, 10, 6, RESPA_OUTER, 0, 0, 0, 0>();
+    return;
+  }
+
+  const double t0 = platform::walltime();
+  if (evflag) {
+    if (eflag_either) {
+      if (vflag_either) eval_respa<12, 10, 6, RESPA_OUTER, 1, 1, 1, 1>();
+      else eval_respa<12, 10, 6, RESPA_OUTER, 1, 1, 0, 1>();
+    } else {
+      if (vflag_either) eval_respa<12, 10, 6, RESPA_OUTER, 1, 0, 1, 1>();
+      else eval_respa<12, 10, 6, RESPA_OUTER, 1, 0, 0, 1>();
+    }
+  } else eval_respa<12, 10, 6, RESPA_OUTER, 0, 0, 0, 1>();
+  stats_local[STAT_TIME_OUTER] += platform::walltime() - t0;
+  stats_local[STAT_CALLS] += 1.0;
+  if (eflag_global) stats_reduce();
+}
+
+/* ----------------------------------------------------------------------
+   allocate all arrays
+------------------------------------------------------------------------- */
+
+void PairLJETEN::allocate()
+{
+  if (allocated) deallocate();
+  allocated = 1;
+  int n = atom->ntypes + 1;
+  table_stale = compact_stale = 1;
+
+  memory->create(setflag, n, n, "pair:setflag");
+  for (int i = 1; i < n; i++)
+    for (int j = i; j < n; j++) setflag[i][j] = 0;
+
+  memory->create(cutsq, n, n, "pair:cutsq");
+
+  // in sparse mode the default rule covers all type pairs and
+  // no dense coefficient tables are needed
+
+  if (sparse_flag) {
+    for (int i = 1; i < n; i++)
+      for (int j = i; j < n; j++) setflag[i][j] = 1;
+    return;
+  }
+
+  memory->create(cut, n, n, "pair:cut");
+  memory->create(cut_eval, n, n, "pair:cut_eval");
+  memory->create(aterm, n, n, "pair:aterm");
+  memory->create(bterm, n, n, "pair:bterm");
+  memory->create(cterm, n, n, "pair:cterm");
+  memory->create(params, n, n, "pair:params");
+  memory->create(native, n, n, "pair:native");
+  memory->create(coeff_init, n, n, "pair:coeff_init");
+}
+
+/* ----------------------------------------------------------------------
+   free the per type pair tables, in sparse mode only setflag and cutsq
+   exist
+------------------------------------------------------------------------- */
+
+void PairLJETEN::deallocate()
+{
+  memory->destroy(setflag);
+  memory->destroy(cutsq);
+
+  memory->destroy(cut);
+  memory->destroy(cut_eval);
+  memory->destroy(aterm);
+  memory->destroy(bterm);
+  memory->destroy(cterm);
+  memory->destroy(params);
+  memory->destroy(native);
+  memory->destroy(coeff_init);
+  allocated = 0;
+}
+
+/* ----------------------------------------------------------------------
+   global settings
+------------------------------------------------------------------------- */
+
+void PairLJETEN::settings(int narg, char **arg)
+{
+  if (narg < 1) error->all(FLERR, "Illegal pair_style command");
+
+  cut_global = utils::numeric(FLERR, arg[0], false, lmp);
+
+  const int sparse_prev = sparse_flag;
+  q_flag = qderiv_flag = 0;
+  stats_flag = 0;
+  async_flag = 0;
+  compact_flag = 0;
+  allpairs_flag = 0;
+  isolated_flag = 0;
+  native_flag = 0;
+  residue_flag = 0;
+  sparse_flag = 0;
+
+  int iarg = 1;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg], "allpairs") == 0) {
+      allpairs_flag = 1;
+      iarg++;
+    } else if (strcmp(arg[iarg], "isolated") == 0) {
+      allpairs_flag = isolated_flag = 1;
+      iarg++;
+    } else if (strcmp(arg[iarg], "native") == 0) {
+      if (iarg + 3 > narg) error->all(FLERR, "Illegal pair_style command");
+      native_flag = 1;
+      cut_repulsive = utils::numeric(FLERR, arg[iarg + 1], false, lmp);
+      native_emin = utils::numeric(FLERR, arg[iarg + 2], false, lmp);
+      if (cut_repulsive <= 0.0) error->all(FLERR, "Illegal pair_style command");
+      iarg += 3;
+    } else if (strcmp(arg[iarg], "q") == 0) {
+      if (iarg + 4 > narg) error->all(FLERR, "Illegal pair_style command");
+      q_flag = 1;
+      q_beta = utils::numeric(FLERR, arg[iarg + 1], false, lmp);
+      q_lambda = utils::numeric(FLERR, arg[iarg + 2], false, lmp);
+      if (q_beta <= 0.0 || q_lambda <= 0.0) error->all(FLERR, "Illegal pair_style command");
+      read_contact_file(arg[iarg + 3]);
+      iarg += 4;
+    } else if (strcmp(arg[iarg], "qderiv") == 0) {
+      qderiv_flag = 1;
+      iarg++;
+    } else if (strcmp(arg[iarg], "stats") == 0) {
+      stats_flag = 1;
+      iarg++;
+    } else if (strcmp(arg[iarg], "async") == 0) {
+      async_flag = 1;
+      iarg++;
+    } else if (strcmp(arg[iarg], "compact") == 0) {
+      compact_flag = 1;
+      iarg++;
+    } else if (strcmp(arg[iarg], "residue") == 0) {
+      if (iarg + 3 > narg) error->all(FLERR, "Illegal pair_style command");
+      residue_flag = 1;
+      delete[] residue_name;
+      if (utils::strmatch(arg[iarg + 1], "^i_")) residue_name = utils::strdup(arg[iarg + 1] + 2);
+      else residue_name = utils::strdup(arg[iarg + 1]);
+      int nres = utils::inumeric(FLERR, arg[iarg + 2], false, lmp);
+      if (nres <= 0) error->all(FLERR, "Illegal pair_style command");
+      if (nres != nresidue) {
+        nresidue = nres;
+        allocate_residue();
+      }
+      iarg += 3;
+    } else if (strcmp(arg[iarg], "sparse") == 0) {
+      if (iarg + 3 > narg) error->all(FLERR, "Illegal pair_style command");
+      sparse_flag = 1;
+      sparse_a = utils::numeric(FLERR, arg[iarg + 1], false, lmp);
+      sparse_cut = utils::numeric(FLERR, arg[iarg + 2], false, lmp);
+      if (sparse_a < 0.0 || sparse_cut <= 0.0) error->all(FLERR, "Illegal pair_style command");
+      iarg += 3;
+    } else
+      error->all(FLERR, "Unknown pair_style lj/eten keyword: {}", arg[iarg]);
+  }
+  if (allpairs_flag && native_flag)
+    error->all(FLERR, "Pair style lj/eten keywords allpairs and native cannot be combined");
+  if ((q_flag || qderiv_flag) && !native_flag)
+    error->all(FLERR, "Pair style lj/eten keywords q and qderiv require keyword native");
+  if (qderiv_flag && !q_flag) error->all(FLERR, "Pair style lj/eten keyword qderiv requires keyword q");
+
+  // extra quantities reported by compute pair: Q first, then the statistics
+
+  nextra = (q_flag ? 1 : 0) + (stats_flag ? NSTATS : 0);
+  delete[] pvector;
+  pvector = nullptr;
+  if (nextra) {
+    pvector = new double[nextra];
+    for (int k = 0; k < nextra; k++) pvector[k] = 0.0;
+  }
+  comm_reverse = qderiv_flag ? 3 : 0;
+
+  if (residue_flag && (allpairs_flag || native_flag))
+    error->all(FLERR, "Pair style lj/eten keyword residue cannot be combined with allpairs or native");
+
+  if (sparse_flag && (allpairs_flag || native_flag || residue_flag))
+    error->all(FLERR, "Pair style lj/eten keyword sparse cannot be combined with allpairs, native or residue");
+  if (async_flag && (allpairs_flag || native_flag || residue_flag || sparse_flag || stats_flag))
+    error->all(FLERR, "Pair style lj/eten keyword async cannot be combined with allpairs, native, residue, sparse or stats");
+  if (compact_flag && (allpairs_flag || residue_flag || sparse_flag || stats_flag || async_flag))
+    error->all(FLERR, "Pair style lj/eten keyword compact cannot be combined with allpairs, residue, sparse, stats or async");
+  if (allocated && (sparse_flag != sparse_prev))
+    error->all(FLERR, "Pair style lj/eten keyword sparse cannot be changed once coefficients are set");
+
+  // dense per-type coefficients are not available in residue or sparse mode
+
+  writedata = (residue_flag || sparse_flag) ? 0 : 1;
+
+  // reset cutoffs that have been explicitly set
+
+  if (allocated && !sparse_flag) {
+    int i, j;
+    for (i = 1; i <= atom->ntypes; i++)
+      for (j = i; j <= atom->ntypes; j++)
+        if (setflag[i][j]) cut[i][j] = cut_global;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   set coeffs for one or more type pairs
+------------------------------------------------------------------------- */
+
+void PairLJETEN::coeff(int narg, char **arg)
+{
+  if (narg >= 3 && strcmp(arg[2], "file") == 0) {
+    if ((narg != 4 && narg != 6) || strcmp(arg[0], "*") != 0 || strcmp(arg[1], "*") != 0)
+      error->all(FLERR, "Expected pair_coeff * * file <file> [<escale> <dscale>]");
+    if (!allocated) allocate();
+
+    double escale = 1.0, dscale = 1.0;
+    if (narg == 6) {
+      escale = utils::numeric(FLERR, arg[4], false, lmp);
+      dscale = utils::numeric(FLERR, arg[5], false, lmp);
+    }
+    read_coeff_file(arg[3], escale, dscale);
+    return;
+  }
+
+  if (residue_flag)
+    error->all(FLERR, "Pair style lj/eten keyword residue requires pair_coeff * * file <file>");
+
+  // sparse mode: "pair_coeff * *" keeps the default rule for all pairs,
+  // explicit coefficients become overrides
+
+  if (sparse_flag) {
+    if (!allocated) allocate();
+    if (narg == 2) return;
+    if (narg < 5 || narg > 6) error->all(FLERR, "Incorrect args for pair coefficients");
+
+    int ilo, ihi, jlo, jhi;
+    utils::bounds(FLERR, arg[0], 1, atom->ntypes, ilo, ihi, error);
+    utils::bounds(FLERR, arg[1], 1, atom->ntypes, jlo, jhi, error);
+
+    double aterm_one = utils::numeric(FLERR, arg[2], false, lmp);
+    double bterm_one = utils::numeric(FLERR, arg[3], false, lmp);
+    double cterm_one = utils::numeric(FLERR, arg[4], false, lmp);
+    double cut_one = 0.0;
+    if (narg == 6) cut_one = utils::numeric(FLERR, arg[5], false, lmp);
+
+    int count = 0;
+    for (int i = ilo; i <= ihi; i++)
+      for (int j = MAX(jlo, i); j <= jhi; j++) {
+        add_override(i, j, aterm_one, bterm_one, cterm_one, cut_one);
+        count++;
+      }
+
+    if (count == 0) error->all(FLERR, "Incorrect args for pair coefficients");
+    return;
+  }
+
+  if (narg < 5 || narg > 6) error->all(FLERR, "Incorrect args for pair coefficients");
+  if (!allocated) allocate();
+
+  int ilo, ihi, jlo, jhi;
+  utils::bounds(FLERR, arg[0], 1, atom->ntypes, ilo, ihi, error);
+  utils::bounds(FLERR, arg[1], 1, atom->ntypes, jlo, jhi, error);
+
+  double aterm_one = utils::numeric(FLERR, arg[2], false, lmp);
+  double bterm_one = utils::numeric(FLERR, arg[3], false, lmp);
+  double cterm_one = utils::numeric(FLERR, arg[4], false, lmp);
+
+  double cut_one = cut_global;
+  if (narg == 6) cut_one = utils::numeric(FLERR, arg[5], false, lmp);
+
+  int count = 0;
+  for (int i = ilo; i <= ihi; i++) {
+    for (int j = MAX(jlo, i); j <= jhi; j++) {
+      aterm[i][j] = aterm_one;
+      bterm[i][j] = bterm_one;
+      cterm[i][j] = cterm_one;
+      cut[i][j] = cut_one;
+      setflag[i][j] = 1;
+      count++;
+    }
+  }
+
+  if (count == 0) error->all(FLERR, "Incorrect args for pair coefficients");
+}
+
+/* ----------------------------------------------------------------------
+   pair_modify keywords specific to this pair style,
+   all others are passed on to Pair::modify_params()
+------------------------------------------------------------------------- */
+
+void PairLJETEN::modify_params(int narg, char **arg)
+{
+  std::vector<char *> remaining;
+
+  int iarg = 0;
+  while (iarg < narg) {
+    if (strcmp(arg[iarg], "tolerance") == 0) {
+      if (iarg + 2 > narg) error->all(FLERR, "Illegal pair_modify command");
+      cut_tolerance = utils::numeric(FLERR, arg[iarg + 1], false, lmp);
+      if (cut_tolerance < 0.0) error->all(FLERR, "Illegal pair_modify command");
+      iarg += 2;
+    } else if (strcmp(arg[iarg], "reset") == 0) {
+      reset_replica();
+      iarg++;
+    } else if (strcmp(arg[iarg], "table/lj") == 0) {
+      if (iarg + 3 > narg) error->all(FLERR, "Illegal pair_modify command");
+      table_bits = utils::inumeric(FLERR, arg[iarg + 1], false, lmp);
+      table_inner = utils::numeric(FLERR, arg[iarg + 2], false, lmp);
+      if (table_bits < 0 || table_bits > 16 || table_inner <= 0.0)
+        error->all(FLERR, "Illegal pair_modify command");
+      table_stale = 1;
+      iarg += 3;
+    } else
+      remaining.push_back(arg[iarg++]);
+  }
+
+  if (!remaining.empty()) Pair::modify_params(remaining.size(), remaining.data());
+}
+
+/* ----------------------------------------------------------------------
+   read coefficients of all type pairs from one file on proc 0, bcast
+
+   binary files start with the 8 byte magic LJETEN_MAGIC and the int
+   number of types, followed by COEFF_PER_PAIR doubles for every pair
+   i <= j in row order: setflag, A, B, C, cut.
+   text files hold one "i j A B C [cut]" line per type pair, the layout
+   of write_coeff and the PairIJ Coeffs section, with # comments.
+
+   in residue mode i and j are residue indices and a binary file holds
+   the inter chain table followed by the intra chain table. text lines
+   read "i j inter|intra A B C [cut]".
+
+   in sparse mode only text files are read and every line becomes an
+   override, no dense table is formed.
+
+   A, B and C are scaled by escale*dscale^12, ^10 and ^6, cut by dscale.
+   a cut <= 0.0 or a missing cut selects the global cutoff.
+------------------------------------------------------------------------- */
+
+void PairLJETEN::read_coeff_file(const char *file, double escale, double dscale)
+{
+  const int ntable = residue_flag ? 2 : 1;
+  const int ntypes = residue_flag ? nresidue : atom->ntypes;
+  const int ncoeff = ntable * COEFF_PER_PAIR * ntypes * (ntypes + 1) / 2;
+  double *buf = nullptr;
+  std::vector<double> records;    // sparse mode: i, j, A, B, C, cut
+  if (!sparse_flag) memory->create(buf, ncoeff, "pair:coeffbuf");
+
+  load_coeff_file(file, escale, dscale, buf, records);
+
+  int count = 0;
+  if (sparse_flag) {
+    const int nrecord = records.size() / 6;
+    for (int n = 0; n < nrecord; n++) {
+      const double *one = &records[6 * n];
+      add_override((int) one[0], (int) one[1], one[2], one[3], one[4], one[5]);
+    }
+    count = nrecord;
+  } else {
+    count = residue_flag ? unpack_residue(buf) : unpack_coeff(buf);
+    memory->destroy(buf);
+  }
+
+  if (count == 0) error->all(FLERR, "No type pairs in lj/eten coefficient file {}", file);
+
+  // all atom types are covered by the residue tables
+
+  if (residue_flag)
+    for (int i = 1; i <= atom->ntypes; i++)
+      for (int j = i; j <= atom->ntypes; j++) {
+        aterm[i][j] = bterm[i][j] = cterm[i][j] = 0.0;
+        cut[i][j] = cut_global;
+        setflag[i][j] = 1;
+      }
+}
+
+/* ----------------------------------------------------------------------
+   parse a coefficient file on proc 0 into buf, or into records in
+   sparse mode, and bcast it. buf holds ncoeff doubles of the dense
+   layout, type pairs missing from the file have setflag 0.
+------------------------------------------------------------------------- */
+
+void PairLJETEN::load_coeff_file(const char *file, double escale, double dscale, double *buf,
+                                 std::vector<double> &records)
+{
+  const int ntable = residue_flag ? 2 : 1;
+  const int ntypes = residue_flag ? nresidue : atom->ntypes;
+  const int npair = ntypes * (ntypes + 1) / 2;
+  const int ncoeff = ntable * COEFF_PER_PAIR * npair;
+  const std::size_t nword = residue_flag ? 6 : 5;
+
+  if (comm->me == 0) {
+    records.clear();
+    for (int n = 0; n < ncoeff && buf; n++) buf[n] = 0.0;
+
+    FILE *fp = fopen(file, "rb");
+    if (!fp) error->one(FLERR, "Cannot open lj/eten coefficient file {}: {}", file, utils::getsyserror());
+
+    char magic[8];
+    if ((fread(magic, 1, 8, fp) == 8) && (memcmp(magic, LJETEN_MAGIC, 8) == 0)) {
+      if (sparse_flag)
+        error->one(FLERR, "Pair style lj/eten keyword sparse does not support binary coefficient file {}", file);
+      int ntypes_file;
+      utils::sfread(FLERR, &ntypes_file, sizeof(int), 1, fp, file, error);
+      if (ntypes_file != ntypes)
+        error->one(FLERR, "lj/eten coefficient file {} has {} {}, expected {}", file, ntypes_file,
+                   residue_flag ? "residues" : "atom types", ntypes);
+      utils::sfread(FLERR, buf, sizeof(double), ncoeff, fp, file, error);
+    } else {
+      rewind(fp);
+      char line[MAXLINE];
+      int nline = 0;
+      while (fgets(line, MAXLINE, fp)) {
+        nline++;
+        auto words = utils::split_words(utils::trim_comment(line));
+        if (words.empty()) continue;
+        if ((words.size() < nword) || (words.size() > nword + 1) || !utils::is_integer(words[0]) ||
+            !utils::is_integer(words[1]))
+          error->one(FLERR, "Invalid line {} in lj/eten coefficient file {}", nline, file);
+
+        int table = 0;
+        if (residue_flag) {
+          if (words[2] == "intra") table = 1;
+          else if (words[2] != "inter")
+            error->one(FLERR, "Invalid line {} in lj/eten coefficient file {}", nline, file);
+          words.erase(words.begin() + 2);
+        }
+        for (std::size_t w = 2; w < words.size(); w++)
+          if (!utils::is_double(words[w]))
+            error->one(FLERR, "Invalid line {} in lj/eten coefficient file {}", nline, file);
+
+        int i = std::stoi(words[0]);
+        int j = std::stoi(words[1]);
+        if (i > j) std::swap(i, j);
+        if (i < 1 || j > ntypes)
+          error->one(FLERR, "Invalid {} in line {} of lj/eten coefficient file {}",
+                     residue_flag ? "residue" : "atom type", nline, file);
+
+        if (sparse_flag) {
+          records.insert(records.end(), {(double) i, (double) j, std::stod(words[2]), std::stod(words[3]),
+                                         std::stod(words[4]), (words.size() == 6) ? std::stod(words[5]) : 0.0});
+          continue;
+        }
+
+        double *one = buf + COEFF_PER_PAIR * (table * npair + (i - 1) * ntypes - (i - 1) * (i - 2) / 2 + (j - i));
+        one[0] = 1.0;
+        one[1] = std::stod(words[2]);
+        one[2] = std::stod(words[3]);
+        one[3] = std::stod(words[4]);
+        one[4] = (words.size() == 6) ? std::stod(words[5]) : 0.0;
+      }
+    }
+    fclose(fp);
+
+    // apply unit scaling once
+
+    const double d2 = dscale * dscale;
+    const double d6 = d2 * d2 * d2;
+    auto scale = [&](double *abc) {
+      abc[0] *= escale * d6 * d6;
+      abc[1] *= escale * d6 * d2 * d2;
+      abc[2] *= escale * d6;
+      abc[3] *= dscale;
+    };
+    if (sparse_flag)
+      for (std::size_t n = 0; n < records.size(); n += 6) scale(&records[n + 2]);
+    else
+      for (int n = 0; n < ntable * npair; n++) scale(buf + COEFF_PER_PAIR * n + 1);
+  }
+
+  if (sparse_flag) {
+    int nrecord = records.size() / 6;
+    MPI_Bcast(&nrecord, 1, MPI_INT, 0, world);
+    records.resize(6 * nrecord);
+    MPI_Bcast(records.data(), 6 * nrecord, MPI_DOUBLE, 0, world);
+  } else
+    MPI_Bcast(buf, ncoeff, MPI_DOUBLE, 0, world);
+}
+
+/* ----------------------------------------------------------------------
+   pack coefficients of all type pairs i <= j, COEFF_PER_PAIR per pair,
+   in the layout read by unpack_coeff() and binary coefficient files
+------------------------------------------------------------------------- */
+
+void PairLJETEN::pack_coeff(double *buf)
+{
+  for (int i = 1; i <= atom->ntypes; i++)
+    for (int j = i; j <= atom->ntypes; j++) {
+      buf[0] = setflag[i][j];
+      buf[1] = setflag[i][j] ? aterm[i][j] : 0.0;
+      buf[2] = setflag[i][j] ? bterm[i][j] : 0.0;
+      buf[3] = setflag[i][j] ? cterm[i][j] : 0.0;
+      buf[4] = setflag[i][j] ? cut[i][j] : 0.0;
+      buf += COEFF_PER_PAIR;
+    }
+}
+
+/* ----------------------------------------------------------------------
+   set all type pairs flagged in a packed coefficient buffer,
+   return the number of pairs set
+------------------------------------------------------------------------- */
+
+int PairLJETEN::unpack_coeff(const double *buf)
+{
+  int count = 0;
+  for (int i = 1; i <= atom->ntypes; i++)
+    for (int j = i; j <= atom->ntypes; j++) {
+      const double *one = buf;
+      buf += COEFF_PER_PAIR;
+      if (one[0] == 0.0) continue;
+      aterm[i][j] = one[1];
+      bterm[i][j] = one[2];
+      cterm[i][j] = one[3];
+      cut[i][j] = (one[4] > 0.0) ? one[4] : cut_global;
+      setflag[i][j] = 1;
+      count++;
+    }
+  return count;
+}
+
+/* ----------------------------------------------------------------------
+   merge flagged entries of both packed residue tables into res_coeff,
+   return the number of residue pairs set
+------------------------------------------------------------------------- */
+
+int PairLJETEN::unpack_residue(const double *buf)
+{
+  const int npair = 2 * nresidue * (nresidue + 1) / 2;
+
+  int count = 0;
+  for (int n = 0; n < npair; n++) {
+    const double *one = buf + COEFF_PER_PAIR * n;
+    if (one[0] == 0.0) continue;
+    for (int k = 0; k < COEFF_PER_PAIR; k++) res_coeff[COEFF_PER_PAIR * n + k] = one[k];
+    count++;
+  }
+  return count;
+}
+
+/* ----------------------------------------------------------------------
+   (re)allocate the residue tables for nresidue residues
+------------------------------------------------------------------------- */
+
+void PairLJETEN::allocate_residue()
+{
+  const int ncoeff = 2 * COEFF_PER_PAIR * nresidue * (nresidue + 1) / 2;
+
+  memory->destroy(res_coeff);
+  memory->destroy(res_params);
+  memory->create(res_coeff, ncoeff, "pair:res_coeff");
+  memory->create(res_params, 2, nresidue + 1, nresidue + 1, "pair:res_params");
+  for (int n = 0; n < ncoeff; n++) res_coeff[n] = 0.0;
+  memset(&res_params[0][0][0], 0, sizeof(Param) * 2 * (nresidue + 1) * (nresidue + 1));
+}
+
+/* ----------------------------------------------------------------------
+   init specific to this pair style
+------------------------------------------------------------------------- */
+
+void PairLJETEN::init_style()
+{
+  // consumers of Q and dQ/dx extract them again in their own init()
+
+  q_request = qderiv_request = 0;
+
+  // the tolerance statistics cover the init_one() calls of Pair::init()
+
+  tol_pending = (cut_tolerance > 0.0) ? 1 : 0;
+  if (tol_pending) {
+    tol_count = tol_tightened = 0;
+    tol_min = cut_global;
+    tol_max = tol_sum = 0.0;
+    for (int k = 0; k < 10; k++) tol_histo[k] = 0;
+  }
+
+  if (fdotr_forced) no_virial_fdotr_compute = fdotr_saved;
+  fdotr_forced = 0;
+
+  if (allpairs_flag || native_flag) {
+    if (suffix_flag || kokkosable)
+      error->all(FLERR, "Pair style lj/eten keywords allpairs and native are not supported by accelerator styles");
+    if (utils::strmatch(update->integrate_style, "^respa") &&
+        (dynamic_cast<Respa *>(update->integrate))->level_inner >= 0)
+      error->all(FLERR, "Pair style lj/eten keywords allpairs and native do not support rRESPA inner levels");
+  }
+
+  if (stats_flag) {
+    if (suffix_flag || kokkosable)
+      error->all(FLERR, "Pair style lj/eten keyword stats is not supported by accelerator styles");
+    stats_reset();
+  }
+
+  if (async_flag) {
+    if (suffix_flag || kokkosable)
+      error->all(FLERR, "Pair style lj/eten keyword async is not supported by accelerator styles");
+    if (force->newton_pair)
+      error->all(FLERR, "Pair style lj/eten keyword async requires newton pair off");
+    if (force->pair != this)
+      error->all(FLERR, "Pair style lj/eten keyword async cannot be used as a hybrid sub-style");
+    if (utils::strmatch(update->integrate_style, "^respa") && (comm->me == 0))
+      error->warning(FLERR, "Pair style lj/eten keyword async has no effect with rRESPA");
+
+    // the worker tallies the virial itself, atom->f lacks its forces until the join
+
+    force_explicit_virial();
+  }
+
+  if (table_bits) {
+    if (suffix_flag || kokkosable)
+      error->all(FLERR, "Pair style lj/eten pair_modify table/lj is not supported by accelerator styles");
+    if (allpairs_flag || residue_flag || sparse_flag)
+      error->all(FLERR, "Pair style lj/eten pair_modify table/lj cannot be combined with allpairs, residue or sparse");
+    if (utils::strmatch(update->integrate_style, "^respa"))
+      error->all(FLERR, "Pair style lj/eten pair_modify table/lj does not support rRESPA");
+    if (compact_flag)
+      error->all(FLERR, "Pair style lj/eten pair_modify table/lj cannot be combined with keyword compact");
+    table_stale = table_report = 1;
+  }
+
+  if (compact_flag) {
+    if (suffix_flag || kokkosable)
+      error->all(FLERR, "Pair style lj/eten keyword compact is not supported by accelerator styles");
+    if (utils::strmatch(update->integrate_style, "^respa"))
+      error->all(FLERR, "Pair style lj/eten keyword compact does not support rRESPA");
+    compact_stale = 1;
+  }
+
+  // the join fix must follow every other post_force fix, so it is
+  // re-added at the end of the fix list on every init
+
+  if (modify->get_fix_by_id(ASYNC_FIX_ID)) modify->delete_fix(ASYNC_FIX_ID);
+  if (async_flag) modify->add_fix(ASYNC_FIX_ID + " all " + ASYNC_FIX_ID);
+
+  if (residue_flag) {
+    if (suffix_flag || kokkosable)
+      error->all(FLERR, "Pair style lj/eten keyword residue is not supported by accelerator styles");
+    if (utils::strmatch(update->integrate_style, "^respa"))
+      error->all(FLERR, "Pair style lj/eten keyword residue does not support rRESPA");
+    if (cut_tolerance > 0.0)
+      error->all(FLERR, "Pair style lj/eten keyword residue does not support pair_modify tolerance");
+    setup_residue();
+  }
+
+  if (sparse_flag) {
+    if (suffix_flag || kokkosable)
+      error->all(FLERR, "Pair style lj/eten keyword sparse is not supported by accelerator styles");
+    if (utils::strmatch(update->integrate_style, "^respa"))
+      error->all(FLERR, "Pair style lj/eten keyword sparse does not support rRESPA");
+    if (cut_tolerance > 0.0)
+      error->all(FLERR, "Pair style lj/eten keyword sparse does not support pair_modify tolerance");
+    setup_sparse();
+  }
+
+  // allpairs mode loops over a fixed pair list instead of a neighbor list
+
+  if (allpairs_flag) {
+    cut_respa = nullptr;
+
+    // forces on images of j are applied to the owned atom directly
+
+    force_explicit_virial();
+    if (isolated_flag && domain->triclinic)
+      error->all(FLERR, "Pair style lj/eten keyword isolated requires an orthogonal box");
+    setup_allpairs();
+    return;
+  }
+
+  // request regular or rRESPA neighbor list
+
+  int list_style = NeighConst::REQ_DEFAULT;
+
+  if (update->whichflag == 1 && utils::strmatch(update->integrate_style, "^respa")) {
+    auto respa = dynamic_cast<Respa *>(update->integrate);
+    if (respa->level_inner >= 0) list_style = NeighConst::REQ_RESPA_INOUT;
+    if (respa->level_middle >= 0) list_style = NeighConst::REQ_RESPA_ALL;
+  }
+  neighbor->add_request(this, list_style);
+
+  if (native_flag) setup_native();
+
+  // set rRESPA cutoffs
+
+  if (utils::strmatch(update->integrate_style, "^respa") &&
+      (dynamic_cast<Respa *>(update->integrate))->level_inner >= 0)
+    cut_respa = (dynamic_cast<Respa *>(update->integrate))->cutoff;
+  else
+    cut_respa = nullptr;
+}
+
+/* ----------------------------------------------------------------------
+   report the tolerance statistics once all type pairs were initialized
+------------------------------------------------------------------------- */
+
+void PairLJETEN::setup()
+{
+  if (tol_pending) tolerance_report(cut_global);
+  tol_pending = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairLJETEN::force_explicit_virial()
+{
+  if (!fdotr_forced) fdotr_saved = no_virial_fdotr_compute;
+  fdotr_forced = 1;
+  no_virial_fdotr_compute = 1;
+}
+
+/* ----------------------------------------------------------------------
+   init for one type pair i,j and corresponding j,i
+------------------------------------------------------------------------- */
+
+double PairLJETEN::init_one(int i, int j)
+{
+  update_scale();
+  if (sparse_flag) return init_one_sparse(i, j);
+
+  if (setflag[i][j] == 0) {
+    aterm[i][j] = 0.0;
+    bterm[i][j] = 0.0;
+    cterm[i][j] = 0.0;
+    cut[i][j] = mix_distance(cut[i][i], cut[j][j]);
+  }
+
+  aterm[i][j] = aterm[i][j];
+  bterm[i][j] = bterm[i][j];
+  cterm[i][j] = cterm[i][j];
+
+  // tighten the cutoff to where energy and force fall below the tolerance
+
+  double cut_one = cut[i][j];
+  if (cut_tolerance > 0.0) cut_one = tolerance_cutoff(i, j, cut[i][j]);
+  cut_eval[i][j] = cut_eval[j][i] = cut_one;
+
+  coeff_init[i][j] = {aterm[i][j], bterm[i][j], cterm[i][j]};
+  table_stale = 1;
+
+  Param &p = params[i][j];
+  p.cutsq = cut_one * cut_one;
+  p.lj1 = 12.0 * scale_param * aterm[i][j];
+  p.lj2 = 10.0 * scale_param * bterm[i][j];
+  p.lj3 = 6.0 * scale_param * cterm[i][j];
+  p.lj4 = scale_param * aterm[i][j];
+  p.lj5 = scale_param * bterm[i][j];
+  p.lj6 = scale_param * cterm[i][j];
+
+  // in native mode native pairs are skipped by the neighbor list loop,
+  // all others only need the short repulsive cutoff
+
+  if (native_flag) {
+    native[j][i] = native[i][j];
+    if (native[i][j]) p.cutsq = 0.0;
+    else {
+      cut_one = MIN(cut_one, cut_repulsive);
+      p.cutsq = cut_one * cut_one;
+    }
+  }
+
+  // shift the energy to zero at the cutoff the pair is evaluated with
+
+  if (offset_flag && (cut_one > 0.0)) {
+    double rc2inv = 1.0 / (cut_one * cut_one);
+    double rc6inv = rc2inv * rc2inv * rc2inv;
+    p.offset = rc6inv * (p.lj4 * rc6inv - p.lj5 * rc2inv * rc2inv + p.lj6);
+  } else
+    p.offset = 0.0;
+
+  if (tol_pending) {
+    tol_count++;
+    if (cut_eval[i][j] < cut[i][j]) tol_tightened++;
+    tol_min = MIN(tol_min, cut_eval[i][j]);
+    tol_max = MAX(tol_max, cut_eval[i][j]);
+    tol_sum += cut_eval[i][j];
+    int bin = static_cast<int>(10.0 * cut_eval[i][j] / cut_global);
+    tol_histo[MAX(0, MIN(bin, 9))]++;
+  }
+
+  params[j][i] = p;
+
+  // check interior rRESPA cutoff
+
+  if (cut_respa && cut[i][j] < cut_respa[3])
+    error->all(FLERR, "Pair cutoff < Respa interior cutoff");
+
+  // compute I,J contribution to long-range tail correction
+  // count total # of atoms of type I and J via Allreduce
+
+  if (tail_flag && !residue_flag) { // Nico: sorry, no clue what this does, please don't use tail correction
+    int *type = atom->type; //Also there was a segmentation fault somewhere in here, it may have been from instantiating sigma and epsilon...so I personally wouldn't use restarts either...
+    int nlocal = atom->nlocal;
+
+    double count[2], all[2];
+    count[0] = count[1] = 0.0;
+    for (int k = 0; k < nlocal; k++) {
+      if (type[k] == i) count[0] += 1.0;
+      if (type[k] == j) count[1] += 1.0;
+    }
+    MPI_Allreduce(count, all, 2, MPI_DOUBLE, MPI_SUM, world);
+
+    double sig2 = aterm[i][j] * aterm[i][j];
+    double sig6 = sig2 * sig2 * sig2;
+    double rc3 = cut[i][j] * cut[i][j] * cut[i][j];
+    double rc6 = rc3 * rc3;
+    double rc9 = rc3 * rc6;
+    double prefactor = 8.0 * MY_PI * all[0] * all[1] * bterm[i][j] * sig6 / (9.0 * rc9);
+    etail_ij = prefactor * (sig6 - 3.0 * rc6);
+    ptail_ij = 2.0 * prefactor * (2.0 * sig6 - 3.0 * rc6);
+  }
+
+  // in residue mode the neighbor cutoff covers all residue pairs
+
+  if (residue_flag) return res_cutmax;
+
+  // an isolated molecule interacts with no ghost atom, so the neighbor
+  // and ghost cutoff shrink to the skin
+
+  if (isolated_flag) return 0.0;
+  return cut_one;
+}
+
+/* ----------------------------------------------------------------------
+   re-derive parameters after fix adapt or compute fep changed the
+   coefficients. only type pairs whose A, B or C differ from those of
+   their last init_one() are recomputed. a new global scale costs
+   nothing for styles that apply it in their kernels and needs all type
+   pairs for the others.
+------------------------------------------------------------------------- */
+
+void PairLJETEN::reinit()
+{
+  if (!reinitflag) error->all(FLERR, "Fix adapt interface to this pair style not supported");
+
+  const double scale_param_old = scale_param;
+  const double scale_kernel_old = scale_kernel;
+  update_scale();
+
+  // tables contain the kernel scale as well
+
+  if (scale_kernel != scale_kernel_old) table_stale = 1;
+
+  // residue and sparse tables do not depend on aterm, bterm, cterm
+
+  if (residue_flag || sparse_flag) return;
+
+  // the tail correction sums over all type pairs
+
+  const int all = (scale_param != scale_param_old) || tail_flag;
+  if (tail_flag) etail = ptail = 0.0;
+  reinit_partial = !all;
+
+  double cut_one;
+  for (int i = 1; i <= atom->ntypes; i++)
+    for (int j = i; j <= atom->ntypes; j++) {
+      const CoeffInit &c = coeff_init[i][j];
+      if (!all && (aterm[i][j] == c.a) && (bterm[i][j] == c.b) && (cterm[i][j] == c.c)) continue;
+      cut_one = init_one(i, j);
+      cutsq[i][j] = cutsq[j][i] = cut_one * cut_one;
+      if (tail_flag) {
+        etail += etail_ij;
+        ptail += ptail_ij;
+        if (i != j) {
+          etail += etail_ij;
+          ptail += ptail_ij;
+        }
+      }
+    }
+  reinit_partial = 0;
+}
+
+/* ----------------------------------------------------------------------
+   split the global scale into the part applied by the kernels and the
+   part folded into params
+------------------------------------------------------------------------- */
+
+void PairLJETEN::update_scale()
+{
+  scale_kernel = scale_in_kernel ? scale_global : 1.0;
+  scale_param = scale_in_kernel ? 1.0 : scale_global;
+}
+
+/* ----------------------------------------------------------------------
+   special bond factors with the global scale of the kernels applied
+------------------------------------------------------------------------- */
+
+void PairLJETEN::scaled_special(double *special) const
+{
+  for (int k = 0; k < 4; k++) special[k] = scale_kernel * force->special_lj[k];
+}
+
+/* ----------------------------------------------------------------------
+   look up the residue property and derive both residue tables.
+   the property must be communicated to ghost atoms, i.e. be defined
+   with fix property/atom ... ghost yes. unset residue pairs do not
+   interact.
+------------------------------------------------------------------------- */
+
+void PairLJETEN::setup_residue()
+{
+  if (!atom->molecule_flag)
+    error->all(FLERR, "Pair style lj/eten keyword residue requires molecule IDs");
+
+  int flag, cols, ghost;
+  residue_index = atom->find_custom_ghost(residue_name, flag, cols, ghost);
+  if ((residue_index < 0) || flag || cols)
+    error->all(FLERR, "Pair style lj/eten residue property i_{} does not exist", residue_name);
+  if (!ghost)
+    error->all(FLERR, "Pair style lj/eten residue property i_{} must be communicated to ghost atoms",
+               residue_name);
+
+  const int *residue = atom->ivector[residue_index];
+  int bad = 0, anybad;
+  for (int i = 0; i < atom->nlocal; i++)
+    if ((residue[i] < 1) || (residue[i] > nresidue)) bad = 1;
+  MPI_Allreduce(&bad, &anybad, 1, MPI_INT, MPI_MAX, world);
+  if (anybad) error->all(FLERR, "Pair style lj/eten residue index out of range 1 to {}", nresidue);
+
+  const int npair = nresidue * (nresidue + 1) / 2;
+  int nunset = 0;
+  res_cutmax = 0.0;
+
+  for (int table = 0; table < 2; table++) {
+    const double *one = res_coeff + COEFF_PER_PAIR * table * npair;
+    for (int i = 1; i <= nresidue; i++)
+      for (int j = i; j <= nresidue; j++, one += COEFF_PER_PAIR) {
+        Param &p = res_params[table][i][j];
+        if (one[0] == 0.0) {
+          p.cutsq = p.lj1 = p.lj2 = p.lj3 = p.lj4 = p.lj5 = p.lj6 = p.offset = 0.0;
+          res_params[table][j][i] = p;
+          nunset++;
+          continue;
+        }
+
+        const double cut_one = (one[4] > 0.0) ? one[4] : cut_global;
+        res_cutmax = MAX(res_cutmax, cut_one);
+        p.cutsq = cut_one * cut_one;
+        p.lj1 = 12.0 * one[1];
+        p.lj2 = 10.0 * one[2];
+        p.lj3 = 6.0 * one[3];
+        p.lj4 = one[1];
+        p.lj5 = one[2];
+        p.lj6 = one[3];
+        p.offset = 0.0;
+        if (offset_flag) {
+          double rc2inv = 1.0 / p.cutsq;
+          double rc6inv = rc2inv * rc2inv * rc2inv;
+          p.offset = rc6inv * (p.lj4 * rc6inv - p.lj5 * rc2inv * rc2inv + p.lj6);
+        }
+        res_params[table][j][i] = p;
+      }
+  }
+
+  if (res_cutmax == 0.0) error->all(FLERR, "Pair style lj/eten residue tables are empty");
+  if (nunset && (comm->me == 0))
+    error->warning(FLERR, "Pair style lj/eten: {} of {} residue pairs are not set and do not interact",
+                   nunset, 2 * npair);
+}
+
+/* ----------------------------------------------------------------------
+   neighbor list loop with parameters looked up by residue index
+   and whether both atoms belong to the same molecule
+------------------------------------------------------------------------- */
+
+template <int STATS> void PairLJETEN::compute_residue(int eflag, int vflag)
+{
+  int i, j, ii, jj, inum, jnum, ires;
+  double xtmp, ytmp, ztmp, delx, dely, delz, evdwl, fpair;
   double rsq, r2inv, r6inv, forcelj, factor_lj;
   int *ilist, *jlist, *numneigh, **firstneigh;
+  tagint imol;
+  bigint nvisited = 0, ninside = 0, nspecial = 0;
 
   evdwl = 0.0;
   ev_init(eflag, vflag);
 
   double **x = atom->x;
   double **f = atom->f;
-  int *type = atom->type;
+  int *residue = atom->ivector[residue_index];
+  tagint *molecule = atom->molecule;
   int nlocal = atom->nlocal;
-  double *special_lj = force->special_lj;
+  double special_lj[4];
+  scaled_special(special_lj);
   int newton_pair = force->newton_pair;
 
+  Param **inter = res_params[0];
+  Param **intra = res_params[1];
+
   inum = list->inum;
   ilist = list->ilist;
   numneigh = list->numneigh;
@@ -98,9 +1468,11 @@ void PairLJETEN::compute(int eflag, int vflag)
     xtmp = x[i][0];
     ytmp = x[i][1];
     ztmp = x[i][2];
-    itype = type[i];
+    ires = residue[i];
+    imol = molecule[i];
     jlist = firstneigh[i];
     jnum = numneigh[i];
+    if (STATS) nvisited += jnum;
 
     for (jj = 0; jj < jnum; jj++) {
       j = jlist[jj];
@@ -111,12 +1483,17 @@ void PairLJETEN::compute(int eflag, int vflag)
       dely = ytmp - x[j][1];
       delz = ztmp - x[j][2];
       rsq = delx * delx + dely * dely + delz * delz;
-      jtype = type[j];
 
-      if (rsq < cutsq[itype][jtype]) {
+      const Param &p = (molecule[j] == imol) ? intra[ires][residue[j]] : inter[ires][residue[j]];
+
+      if (rsq < p.cutsq) {
+        if (STATS) {
+          ninside++;
+          if (factor_lj != 1.0) nspecial++;
+        }
         r2inv = 1.0 / rsq;
         r6inv = r2inv * r2inv * r2inv;
-        forcelj = r6inv * (lj1[itype][jtype] * r6inv - lj2[itype][jtype] * r2inv * r2inv + lj3[itype][jtype]);
+        forcelj = r6inv * (p.lj1 * r6inv - p.lj2 * r2inv * r2inv + p.lj3);
         fpair = factor_lj * forcelj * r2inv;
 
         f[i][0] += delx * fpair;
@@ -129,7 +1506,7 @@ void PairLJETEN::compute(int eflag, int vflag)
         }
 
         if (eflag) {
-          evdwl = r6inv * (lj4[itype][jtype] * r6inv - lj5[itype][jtype] * r2inv * r2inv + lj6[itype][jtype]) - offset[itype][jtype];
+          evdwl = r6inv * (p.lj4 * r6inv - p.lj5 * r2inv * r2inv + p.lj6) - p.offset;
           evdwl *= factor_lj;
         }
 
@@ -138,36 +1515,139 @@ void PairLJETEN::compute(int eflag, int vflag)
     }
   }
 
+  if (STATS) {
+    stats_local[STAT_VISITED] += nvisited;
+    stats_local[STAT_INSIDE] += ninside;
+    stats_local[STAT_SPECIAL] += nspecial;
+  }
+
   if (vflag_fdotr) virial_fdotr_compute();
 }
 
-/* ---------------------------------------------------------------------- */
+/* ----------------------------------------------------------------------
+   append one sparse override for type pair i,j
+------------------------------------------------------------------------- */
 
-void PairLJETEN::compute_inner()
+void PairLJETEN::add_override(int i, int j, double a, double b, double c, double cut_one)
 {
-  int i, j, ii, jj, inum, jnum, itype, jtype;
-  double xtmp, ytmp, ztmp, delx, dely, delz, fpair;
-  double rsq, r2inv, r6inv, forcelj, factor_lj, rsw;
+  if (noverride == maxoverride) {
+    maxoverride += DELTA_OVERRIDE;
+    overrides = (Override *) memory->srealloc(overrides, maxoverride * sizeof(Override), "pair:overrides");
+  }
+  Override &one = overrides[noverride++];
+  one.i = MIN(i, j);
+  one.j = MAX(i, j);
+  one.a = a;
+  one.b = b;
+  one.c = c;
+  one.cut = cut_one;
+}
+
+/* ----------------------------------------------------------------------
+   convert the overrides into CSR rows of both type orderings,
+   a later override of the same type pair replaces an earlier one
+------------------------------------------------------------------------- */
+
+void PairLJETEN::setup_sparse()
+{
+  const int ntypes = atom->ntypes;
+
+  auto make_param = [&](double a, double b, double c, double cut_one) {
+    Param p;
+    p.cutsq = cut_one * cut_one;
+    p.lj1 = 12.0 * a;
+    p.lj2 = 10.0 * b;
+    p.lj3 = 6.0 * c;
+    p.lj4 = a;
+    p.lj5 = b;
+    p.lj6 = c;
+    p.offset = 0.0;
+    if (offset_flag) {
+      double rc2inv = 1.0 / p.cutsq;
+      double rc6inv = rc2inv * rc2inv * rc2inv;
+      p.offset = rc6inv * (p.lj4 * rc6inv - p.lj5 * rc2inv * rc2inv + p.lj6);
+    }
+    return p;
+  };
+
+  sparse_default = make_param(sparse_a, 0.0, 0.0, sparse_cut);
+
+  // sort (itype, jtype, order) so that the last override of a pair
+  // ends each run of equal itype, jtype
+
+  std::vector<std::array<int, 3>> entries;
+  entries.reserve(2 * noverride);
+  for (int n = 0; n < noverride; n++) {
+    if (overrides[n].j > ntypes) error->all(FLERR, "Pair style lj/eten sparse override type exceeds number of types");
+    entries.push_back({overrides[n].i, overrides[n].j, n});
+    if (overrides[n].i != overrides[n].j) entries.push_back({overrides[n].j, overrides[n].i, n});
+  }
+  std::sort(entries.begin(), entries.end());
+
+  int nunique = 0;
+  for (std::size_t k = 0; k < entries.size(); k++)
+    if ((k + 1 == entries.size()) || (entries[k][0] != entries[k + 1][0]) || (entries[k][1] != entries[k + 1][1]))
+      entries[nunique++] = entries[k];
+
+  memory->destroy(sparse_first);
+  memory->destroy(sparse_jtype);
+  memory->sfree(sparse_params);
+  memory->create(sparse_first, ntypes + 2, "pair:sparse_first");
+  memory->create(sparse_jtype, MAX(nunique, 1), "pair:sparse_jtype");
+  sparse_params = (Param *) memory->smalloc(MAX(nunique, 1) * sizeof(Param), "pair:sparse_params");
+
+  for (int i = 0; i < ntypes + 2; i++) sparse_first[i] = 0;
+  for (int k = 0; k < nunique; k++) {
+    const Override &one = overrides[entries[k][2]];
+    sparse_first[entries[k][0] + 1]++;
+    sparse_jtype[k] = entries[k][1];
+    sparse_params[k] = make_param(one.a, one.b, one.c, (one.cut > 0.0) ? one.cut : cut_global);
+  }
+  for (int i = 1; i < ntypes + 2; i++) sparse_first[i] += sparse_first[i - 1];
+
+  int npair = 0;
+  for (int k = 0; k < nunique; k++)
+    if (entries[k][0] <= entries[k][1]) npair++;
+  if (comm->me == 0)
+    utils::logmesg(lmp, "lj/eten sparse: {} type pair overrides in {:.4g} kB, default repulsion A = {:.8g}\n",
+                   npair, nunique * (sizeof(int) + sizeof(Param)) / 1024.0, sparse_a);
+}
+
+/* ----------------------------------------------------------------------
+   init for one type pair in sparse mode, return its cutoff
+------------------------------------------------------------------------- */
+
+double PairLJETEN::init_one_sparse(int i, int j)
+{
+  return sqrt(sparse_param(i, j).cutsq);
+}
+
+/* ----------------------------------------------------------------------
+   neighbor list loop with parameters from the sparse overrides or
+   the repulsive default rule
+------------------------------------------------------------------------- */
+
+template <int EVFLAG, int EFLAG, int NEWTON_PAIR, int STATS> void PairLJETEN::eval_sparse()
+{
+  int i, j, ii, jj, inum, jnum, itype;
+  double xtmp, ytmp, ztmp, delx, dely, delz, evdwl, fpair;
+  double rsq, r2inv, r6inv, forcelj, factor_lj;
   int *ilist, *jlist, *numneigh, **firstneigh;
+  bigint nvisited = 0, ninside = 0, nspecial = 0;
+
+  evdwl = 0.0;
 
   double **x = atom->x;
   double **f = atom->f;
   int *type = atom->type;
   int nlocal = atom->nlocal;
-  double *special_lj = force->special_lj;
-  int newton_pair = force->newton_pair;
-
-  inum = list->inum_inner;
-  ilist = list->ilist_inner;
-  numneigh = list->numneigh_inner;
-  firstneigh = list->firstneigh_inner;
+  double special_lj[4];
+  scaled_special(special_lj);
 
-  double cut_out_on = cut_respa[0];
-  double cut_out_off = cut_respa[1];
-
-  double cut_out_diff = cut_out_off - cut_out_on;
-  double cut_out_on_sq = cut_out_on * cut_out_on;
-  double cut_out_off_sq = cut_out_off * cut_out_off;
+  inum = list->inum;
+  ilist = list->ilist;
+  numneigh = list->numneigh;
+  firstneigh = list->firstneigh;
 
   // loop over neighbors of my atoms
 
@@ -179,6 +1659,7 @@ void PairLJETEN::compute_inner()
     itype = type[i];
     jlist = firstneigh[i];
     jnum = numneigh[i];
+    if (STATS) nvisited += jnum;
 
     for (jj = 0; jj < jnum; jj++) {
       j = jlist[jj];
@@ -190,391 +1671,1086 @@ void PairLJETEN::compute_inner()
       delz = ztmp - x[j][2];
       rsq = delx * delx + dely * dely + delz * delz;
 
-      if (rsq < cut_out_off_sq) {
+      // cheap reject against the largest cutoff of the type pair first
+
+      if (rsq >= cutsq[itype][type[j]]) continue;
+      const Param &p = sparse_param(itype, type[j]);
+
+      if (rsq < p.cutsq) {
+        if (STATS) {
+          ninside++;
+          if (factor_lj != 1.0) nspecial++;
+        }
         r2inv = 1.0 / rsq;
         r6inv = r2inv * r2inv * r2inv;
-        jtype = type[j];
-        forcelj = r6inv * (lj1[itype][jtype] * r6inv - lj2[itype][jtype] * r2inv * r2inv + lj3[itype][jtype]);
+        forcelj = r6inv * (p.lj1 * r6inv - p.lj2 * r2inv * r2inv + p.lj3);
         fpair = factor_lj * forcelj * r2inv;
-        if (rsq > cut_out_on_sq) {
-          rsw = (sqrt(rsq) - cut_out_on) / cut_out_diff;
-          fpair *= 1.0 - rsw * rsw * (3.0 - 2.0 * rsw);
-        }
 
         f[i][0] += delx * fpair;
         f[i][1] += dely * fpair;
         f[i][2] += delz * fpair;
-        if (newton_pair || j < nlocal) {
+        if (NEWTON_PAIR || j < nlocal) {
           f[j][0] -= delx * fpair;
           f[j][1] -= dely * fpair;
           f[j][2] -= delz * fpair;
         }
+
+        if (EFLAG) evdwl = factor_lj * (r6inv * (p.lj4 * r6inv - p.lj5 * r2inv * r2inv + p.lj6) - p.offset);
+
+        if (EVFLAG) ev_tally(i, j, nlocal, NEWTON_PAIR, evdwl, 0.0, fpair, delx, dely, delz);
       }
     }
   }
+
+  if (STATS) {
+    stats_local[STAT_VISITED] += nvisited;
+    stats_local[STAT_INSIDE] += ninside;
+    stats_local[STAT_SPECIAL] += nspecial;
+  }
 }
 
-/* ---------------------------------------------------------------------- */
+/* ----------------------------------------------------------------------
+   parameters of the pair of atoms i,j with types itype,jtype
+   in the current parameter storage mode
+------------------------------------------------------------------------- */
 
-void PairLJETEN::compute_middle()
+const PairLJETEN::Param &PairLJETEN::lookup_param(int i, int j, int itype, int jtype)
 {
-  int i, j, ii, jj, inum, jnum, itype, jtype;
-  double xtmp, ytmp, ztmp, delx, dely, delz, fpair;
-  double rsq, r2inv, r6inv, forcelj, factor_lj, rsw;
-  int *ilist, *jlist, *numneigh, **firstneigh;
+  if (residue_flag) {
+    const int *residue = atom->ivector[residue_index];
+    return res_params[atom->molecule[i] == atom->molecule[j]][residue[i]][residue[j]];
+  }
+  if (sparse_flag) return sparse_param(itype, jtype);
+  return params[itype][jtype];
+}
+
+/* ----------------------------------------------------------------------
+   build the list of all atom pairs itag < jtag that are not excluded
+   by special_lj, with their special factors resolved once
+------------------------------------------------------------------------- */
+
+void PairLJETEN::setup_allpairs()
+{
+  if (comm->nprocs != 1) error->all(FLERR, "Pair style lj/eten keyword allpairs requires a single MPI rank");
+  if (atom->map_style == Atom::MAP_NONE)
+    error->all(FLERR, "Pair style lj/eten keyword allpairs requires an atom map");
+  if (atom->map_tag_max != atom->natoms)
+    error->all(FLERR, "Pair style lj/eten keyword allpairs requires consecutive atom IDs");
+  if (atom->natoms * (atom->natoms - 1) / 2 > MAXSMALLINT)
+    error->all(FLERR, "Too many atoms for pair style lj/eten keyword allpairs");
+
+  const int natoms = atom->natoms;
+  double *special_lj = force->special_lj;
+
+  double *factor;
+  memory->create(factor, natoms + 1, "pair:factor");
+
+  memory->sfree(allpairs);
+  allpairs = (AllPair *) memory->smalloc(sizeof(AllPair) * natoms * (natoms - 1) / 2 + 1, "pair:allpairs");
+  npair_all = 0;
+
+  for (tagint itag = 1; itag <= natoms; itag++) {
+    const int i = atom->map(itag);
+    for (tagint jtag = itag + 1; jtag <= natoms; jtag++) factor[jtag] = 1.0;
+
+    if (atom->molecular != Atom::ATOMIC) {
+      const int *nspecial = atom->nspecial[i];
+      const tagint *special = atom->special[i];
+      for (int s = 0; s < nspecial[2]; s++) {
+        const int which = (s < nspecial[0]) ? 1 : ((s < nspecial[1]) ? 2 : 3);
+        if (special[s] > itag) factor[special[s]] = special_lj[which];
+      }
+    }
+
+    for (tagint jtag = itag + 1; jtag <= natoms; jtag++) {
+      if (factor[jtag] == 0.0) continue;
+      AllPair &ap = allpairs[npair_all++];
+      ap.itag = itag;
+      ap.jtag = jtag;
+      ap.i = ap.j = ap.jimage = -1;
+      ap.factor_lj = factor[jtag];
+    }
+  }
+
+  memory->destroy(factor);
+  allpairs_stale = 1;
+}
+
+/* ----------------------------------------------------------------------
+   refresh local indices of the pair list after atoms were reordered
+------------------------------------------------------------------------- */
+
+void PairLJETEN::map_allpairs()
+{
+  for (int n = 0; n < npair_all; n++) {
+    AllPair &ap = allpairs[n];
+    ap.i = atom->map(ap.itag);
+    ap.j = atom->map(ap.jtag);
+    if (ap.i < 0 || ap.j < 0) error->one(FLERR, "Pair style lj/eten allpairs atoms {} {} missing", ap.itag, ap.jtag);
+    ap.jimage = isolated_flag ? ap.j : domain->closest_image(ap.i, ap.j);
+  }
+  if (isolated_flag) check_isolated();
+  allpairs_stale = 0;
+}
+
+/* ----------------------------------------------------------------------
+   isolated mode uses owned atoms without images, valid as long as the
+   molecule plus the longest cutoff and the neighbor skin, which the atoms
+   may move by before the next check, fits into every periodic box length
+------------------------------------------------------------------------- */
+
+void PairLJETEN::check_isolated()
+{
+  double cutmaxsq = 0.0;
+  for (int i = 1; i <= atom->ntypes; i++)
+    for (int j = i; j <= atom->ntypes; j++) cutmaxsq = MAX(cutmaxsq, params[i][j].cutsq);
+  const double cutmax = sqrt(cutmaxsq) + neighbor->skin;
+
+  double **x = atom->x;
+  const int nlocal = atom->nlocal;
+  for (int d = 0; d < 3; d++) {
+    if (!domain->periodicity[d] || !nlocal) continue;
+    double lo = x[0][d], hi = x[0][d];
+    for (int i = 1; i < nlocal; i++) {
+      lo = MIN(lo, x[i][d]);
+      hi = MAX(hi, x[i][d]);
+    }
+    if (hi - lo + cutmax > domain->prd[d])
+      error->one(FLERR, "Pair style lj/eten keyword isolated: molecule extent {:.8g} plus cutoff and skin {:.8g} "
+                 "exceeds the periodic box length {:.8g}", hi - lo, cutmax, domain->prd[d]);
+  }
+}
+
+/* ----------------------------------------------------------------------
+   evaluate the fixed pair list, both atoms are owned by this rank and
+   the separation is taken to the image of j closest to i
+------------------------------------------------------------------------- */
+
+void PairLJETEN::compute_allpairs(int eflag, int vflag)
+{
+  int i, j, itype, jtype;
+  double delx, dely, delz, evdwl, fpair;
+  double rsq, r2inv, r6inv, forcelj, factor_lj;
+
+  evdwl = 0.0;
+  ev_init(eflag, vflag);
+
+  // atoms are only reordered when neighbor lists are rebuilt
+
+  if (neighbor->ago == 0 || allpairs_stale) map_allpairs();
 
   double **x = atom->x;
   double **f = atom->f;
   int *type = atom->type;
   int nlocal = atom->nlocal;
-  double *special_lj = force->special_lj;
-  int newton_pair = force->newton_pair;
 
-  inum = list->inum_middle;
-  ilist = list->ilist_middle;
-  numneigh = list->numneigh_middle;
-  firstneigh = list->firstneigh_middle;
+  for (int n = 0; n < npair_all; n++) {
+    const AllPair &ap = allpairs[n];
+    i = ap.i;
+    j = ap.j;
+    factor_lj = scale_kernel * ap.factor_lj;
 
-  double cut_in_off = cut_respa[0];
-  double cut_in_on = cut_respa[1];
-  double cut_out_on = cut_respa[2];
-  double cut_out_off = cut_respa[3];
+    delx = x[i][0] - x[ap.jimage][0];
+    dely = x[i][1] - x[ap.jimage][1];
+    delz = x[i][2] - x[ap.jimage][2];
+    rsq = delx * delx + dely * dely + delz * delz;
+    itype = type[i];
+    jtype = type[j];
+
+    const Param &p = params[itype][jtype];
+    if (rsq < p.cutsq) {
+      r2inv = 1.0 / rsq;
+      r6inv = r2inv * r2inv * r2inv;
+      forcelj = r6inv * (p.lj1 * r6inv - p.lj2 * r2inv * r2inv + p.lj3);
+      fpair = factor_lj * forcelj * r2inv;
+
+      f[i][0] += delx * fpair;
+      f[i][1] += dely * fpair;
+      f[i][2] += delz * fpair;
+      f[j][0] -= delx * fpair;
+      f[j][1] -= dely * fpair;
+      f[j][2] -= delz * fpair;
+
+      if (eflag) {
+        evdwl = r6inv * (p.lj4 * r6inv - p.lj5 * r2inv * r2inv + p.lj6) - p.offset;
+        evdwl *= factor_lj;
+      }
 
-  double cut_in_diff = cut_in_on - cut_in_off;
-  double cut_out_diff = cut_out_off - cut_out_on;
-  double cut_in_off_sq = cut_in_off * cut_in_off;
-  double cut_in_on_sq = cut_in_on * cut_in_on;
-  double cut_out_on_sq = cut_out_on * cut_out_on;
-  double cut_out_off_sq = cut_out_off * cut_out_off;
+      if (evflag) ev_tally(i, j, nlocal, 1, evdwl, 0.0, fpair, delx, dely, delz);
+    }
+  }
+}
 
-  // loop over neighbors of my atoms
+/* ----------------------------------------------------------------------
+   well depth epsilon of the 12-10-6 potential from A = 13 eps sigma^12
+   and B = 18 eps sigma^10, 0.0 for purely repulsive type pairs
+------------------------------------------------------------------------- */
 
-  for (ii = 0; ii < inum; ii++) {
-    i = ilist[ii];
-    xtmp = x[i][0];
-    ytmp = x[i][1];
-    ztmp = x[i][2];
-    itype = type[i];
-    jlist = firstneigh[i];
-    jnum = numneigh[i];
+double PairLJETEN::well_depth(int i, int j)
+{
+  if (aterm[i][j] <= 0.0 || bterm[i][j] <= 0.0) return 0.0;
 
-    for (jj = 0; jj < jnum; jj++) {
-      j = jlist[jj];
-      factor_lj = special_lj[sbmask(j)];
-      j &= NEIGHMASK;
+  double sigma2 = 18.0 * aterm[i][j] / (13.0 * bterm[i][j]);
+  double sigma6 = sigma2 * sigma2 * sigma2;
+  return aterm[i][j] / (13.0 * sigma6 * sigma6);
+}
 
-      delx = xtmp - x[j][0];
-      dely = ytmp - x[j][1];
-      delz = ztmp - x[j][2];
-      rsq = delx * delx + dely * dely + delz * delz;
+/* ----------------------------------------------------------------------
+   smallest cutoff up to rmax so that |U| and |F| stay below the
+   tolerance everywhere beyond it, found by scanning inward from rmax
+------------------------------------------------------------------------- */
 
-      if (rsq < cut_out_off_sq && rsq > cut_in_off_sq) {
-        r2inv = 1.0 / rsq;
-        r6inv = r2inv * r2inv * r2inv;
-        jtype = type[j];
-        forcelj = r6inv * (lj1[itype][jtype] * r6inv - lj2[itype][jtype] * r2inv * r2inv + lj3[itype][jtype]);
-        fpair = factor_lj * forcelj * r2inv;
-        if (rsq < cut_in_on_sq) {
-          rsw = (sqrt(rsq) - cut_in_off) / cut_in_diff;
-          fpair *= rsw * rsw * (3.0 - 2.0 * rsw);
-        }
-        if (rsq > cut_out_on_sq) {
-          rsw = (sqrt(rsq) - cut_out_on) / cut_out_diff;
-          fpair *= 1.0 + rsw * rsw * (2.0 * rsw - 3.0);
-        }
+double PairLJETEN::tolerance_cutoff(int i, int j, double rmax)
+{
+  const int nscan = 1000;
+  const double dr = rmax / nscan;
+  double rc = rmax;
+
+  for (int n = nscan; n > 0; n--) {
+    double r = n * dr;
+    double r2inv = 1.0 / (r * r);
+    double r4inv = r2inv * r2inv;
+    double r6inv = r4inv * r2inv;
+    double u = r6inv * (aterm[i][j] * r6inv - bterm[i][j] * r4inv + cterm[i][j]);
+    double f = r6inv * (12.0 * aterm[i][j] * r6inv - 10.0 * bterm[i][j] * r4inv + 6.0 * cterm[i][j]) / r;
+    if (fabs(u) >= cut_tolerance || fabs(f) >= cut_tolerance) break;
+    rc = r;
+  }
+  return rc;
+}
 
-        f[i][0] += delx * fpair;
-        f[i][1] += dely * fpair;
-        f[i][2] += delz * fpair;
-        if (newton_pair || j < nlocal) {
-          f[j][0] -= delx * fpair;
-          f[j][1] -= dely * fpair;
-          f[j][2] -= delz * fpair;
+/* ----------------------------------------------------------------------
+   print the distribution of tightened cutoffs after the last init_one()
+   of Pair::init()
+------------------------------------------------------------------------- */
+
+void PairLJETEN::tolerance_report(double cutmax)
+{
+  if (comm->me != 0) return;
+
+  std::string mesg = fmt::format("  lj/eten tolerance {}: {} of {} type pair cutoffs tightened\n",
+                                 cut_tolerance, tol_tightened, tol_count);
+  mesg += fmt::format("  cutoff min {:.4g} mean {:.4g} max {:.4g}\n", tol_min,
+                      tol_sum / MAX(tol_count, 1), tol_max);
+  for (int k = 0; k < 10; k++)
+    mesg += fmt::format("    [{:8.4g},{:8.4g}) {}\n", 0.1 * k * cutmax, 0.1 * (k + 1) * cutmax, tol_histo[k]);
+  utils::logmesg(lmp, mesg);
+}
+
+/* ----------------------------------------------------------------------
+   clear the statistics accumulated by this rank
+------------------------------------------------------------------------- */
+
+void PairLJETEN::stats_reset()
+{
+  for (double &v : stats_local) v = 0.0;
+}
+
+/* ----------------------------------------------------------------------
+   copy the statistics of this rank to the extra quantities of compute
+   pair behind Q, which sums them over ranks, wall times pre-divided so
+   that the sum is the mean per rank, and reduce the global copy that
+   extract() hands out
+------------------------------------------------------------------------- */
+
+void PairLJETEN::stats_reduce()
+{
+  const int nprocs = comm->nprocs;
+  const int offset = q_flag ? 1 : 0;
+  for (int k = 0; k < NSTATS; k++) {
+    pvector[offset + k] = stats_local[k];
+    if (k >= STAT_TIME && k <= STAT_TIME_OUTER) pvector[offset + k] /= nprocs;
+  }
+
+  MPI_Allreduce(&pvector[offset], stats, NSTATS, MPI_DOUBLE, MPI_SUM, world);
+}
+
+/* ----------------------------------------------------------------------
+   build the tables of all type pairs from single(). the segments of
+   all tables share one grid, segment k starts at the rsq_k whose float
+   bits are (table_base + k) << table_shift. fpair and energy are cubic
+   polynomials in rsq - rsq_k matching value and slope at both ends,
+   the energy slope is exactly -fpair/2, the fpair slope is a central
+   difference.
+------------------------------------------------------------------------- */
+
+void PairLJETEN::table_setup()
+{
+  union_int_float_t rsq_lookup;
+  const int ntypes = atom->ntypes;
+
+  table_shift = 23 - table_bits;
+  rsq_lookup.f = table_inner * table_inner;
+  table_base = rsq_lookup.i >> table_shift;
+  rsq_lookup.i = table_base << table_shift;
+  table_innersq = rsq_lookup.f;
+
+  auto knot = [&](int k) {
+    union_int_float_t lookup;
+    lookup.i = (table_base + k) << table_shift;
+    return (double) lookup.f;
+  };
+
+  // one table per distinct parameter record, reaching up to its cutoff
+
+  std::map<std::array<double, 8>, int> unique;
+  std::vector<std::array<int, 4>> tables;    // itype, jtype, offset, nseg
+  int nseg_total = 0;
+
+  memory->destroy(table_offset);
+  memory->create(table_offset, ntypes + 1, ntypes + 1, "pair:table_offset");
+  for (int i = 1; i <= ntypes; i++)
+    for (int j = i; j <= ntypes; j++) {
+      const Param &p = params[i][j];
+      table_offset[i][j] = table_offset[j][i] = -1;
+      if (p.cutsq <= table_innersq) continue;
+
+      const std::array<double, 8> key = {p.cutsq, p.lj1, p.lj2, p.lj3, p.lj4, p.lj5, p.lj6, p.offset};
+      auto it = unique.find(key);
+      if (it == unique.end()) {
+        rsq_lookup.f = p.cutsq;
+        const int nseg = (rsq_lookup.i >> table_shift) - table_base + 1;
+        it = unique.emplace(key, nseg_total).first;
+        tables.push_back({i, j, nseg_total, nseg});
+        nseg_total += nseg;
+      }
+      table_offset[i][j] = table_offset[j][i] = it->second;
+    }
+
+  memory->sfree(table_segs);
+  table_segs = (TableSeg *) memory->smalloc(sizeof(TableSeg) * MAX(nseg_total, 1), "pair:table_segs");
+
+  for (const auto &t : tables) {
+    const int itype = t[0];
+    const int jtype = t[1];
+
+    auto sample = [&](double rsq, double &fone, double &dfone, double &eone) {
+      const double h = 1.0e-5 * rsq;
+      double fplus, fminus;
+      eone = single(0, 0, itype, jtype, rsq, 0.0, 1.0, fone);
+      single(0, 0, itype, jtype, rsq + h, 0.0, 1.0, fplus);
+      single(0, 0, itype, jtype, rsq - h, 0.0, 1.0, fminus);
+      dfone = (fplus - fminus) / (2.0 * h);
+    };
+
+    double r0 = knot(0), f0, df0, e0;
+    sample(r0, f0, df0, e0);
+    for (int k = 0; k < t[3]; k++) {
+      const double r1 = knot(k + 1);
+      double f1, df1, e1;
+      sample(r1, f1, df1, e1);
+
+      // Hermite cubic y0 + m0 d + c2 d^2 + c3 d^3 on 0 <= d <= w
+
+      const double w = r1 - r0;
+      const double de0 = -0.5 * f0, de1 = -0.5 * f1;
+      TableSeg &seg = table_segs[t[2] + k];
+      seg.f0 = f0;
+      seg.f1 = df0;
+      seg.f2 = (3.0 * (f1 - f0) / w - 2.0 * df0 - df1) / w;
+      seg.f3 = (df0 + df1 - 2.0 * (f1 - f0) / w) / (w * w);
+      seg.e0 = e0;
+      seg.e1 = de0;
+      seg.e2 = (3.0 * (e1 - e0) / w - 2.0 * de0 - de1) / w;
+      seg.e3 = (de0 + de1 - 2.0 * (e1 - e0) / w) / (w * w);
+
+      r0 = r1;
+      f0 = f1;
+      df0 = df1;
+      e0 = e1;
+    }
+  }
+
+  if (table_report && (comm->me == 0))
+    utils::logmesg(lmp, "  lj/eten tables: {} for {} type pairs, {} segments of {} per octave, {:.4g} Mbytes\n",
+                   tables.size(), ntypes * (ntypes + 1) / 2, nseg_total, 1 << table_bits,
+                   sizeof(TableSeg) * nseg_total / 1024.0 / 1024.0);
+  table_report = 0;
+  table_stale = 0;
+}
+
+/* ----------------------------------------------------------------------
+   copy the neighbor list into the compact lists
+------------------------------------------------------------------------- */
+
+void PairLJETEN::compact_build()
+{
+  const int inum = list->inum;
+  const int *ilist = list->ilist;
+  const int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+  const double *special_lj = force->special_lj;
+
+  compact_short = (atom->nlocal + atom->nghost <= 65536) ? 1 : 0;
+
+  int ntotal = 0;
+  for (int ii = 0; ii < inum; ii++) ntotal += numneigh[ilist[ii]];
+
+  if (inum + 1 > max_compact_first) {
+    max_compact_first = inum + 1;
+    memory->destroy(compact_first);
+    memory->create(compact_first, max_compact_first, "pair:compact_first");
+  }
+  if (ntotal > max_compact) {
+    max_compact = ntotal;
+    memory->destroy(compact_j16);
+    memory->destroy(compact_j32);
+  }
+  if (compact_short && !compact_j16) memory->create(compact_j16, MAX(max_compact, 1), "pair:compact_j16");
+  if (!compact_short && !compact_j32) memory->create(compact_j32, MAX(max_compact, 1), "pair:compact_j32");
+
+  int n = 0;
+  ncompact_special = 0;
+  compact_first[0] = 0;
+  for (int ii = 0; ii < inum; ii++) {
+    const int i = ilist[ii];
+    const int *jlist = firstneigh[i];
+    const int jnum = numneigh[i];
+
+    for (int jj = 0; jj < jnum; jj++) {
+      const int which = sbmask(jlist[jj]);
+      const int j = jlist[jj] & NEIGHMASK;
+      if (which == 0) {
+        if (compact_short) compact_j16[n++] = (uint16_t) j;
+        else compact_j32[n++] = j;
+      } else if (special_lj[which] != 0.0) {
+        if (ncompact_special == max_compact_special) {
+          max_compact_special += DELTA_COMPACT;
+          compact_special = (CompactSpecial *) memory->srealloc(
+              compact_special, sizeof(CompactSpecial) * max_compact_special, "pair:compact_special");
         }
+        compact_special[ncompact_special++] = {i, j, which};
       }
     }
+    compact_first[ii + 1] = n;
   }
+  compact_stale = 0;
 }
 
 /* ---------------------------------------------------------------------- */
 
-void PairLJETEN::compute_outer(int eflag, int vflag)
+void PairLJETEN::eval_compact_tally()
 {
-  int i, j, ii, jj, inum, jnum, itype, jtype;
-  double xtmp, ytmp, ztmp, delx, dely, delz, evdwl, fpair;
-  double rsq, r2inv, r6inv, forcelj, factor_lj, rsw;
-  int *ilist, *jlist, *numneigh, **firstneigh;
+  if (neighbor->ago == 0 || compact_stale) compact_build();
+
+  if (compact_short) {
+    if (!evflag) eval_compact<uint16_t, TALLY_NONE, 0, 0>(compact_j16);
+    else if (eflag_atom || vflag_atom || cvflag_atom)
+      eval_compact<uint16_t, TALLY_PAIR, 0, 0>(compact_j16);
+    else if (eflag_global) {
+      if (vflag_global) eval_compact<uint16_t, TALLY_SUM, 1, 1>(compact_j16);
+      else eval_compact<uint16_t, TALLY_SUM, 1, 0>(compact_j16);
+    } else
+      eval_compact<uint16_t, TALLY_SUM, 0, 1>(compact_j16);
+  } else {
+    if (!evflag) eval_compact<int, TALLY_NONE, 0, 0>(compact_j32);
+    else if (eflag_atom || vflag_atom || cvflag_atom)
+      eval_compact<int, TALLY_PAIR, 0, 0>(compact_j32);
+    else if (eflag_global) {
+      if (vflag_global) eval_compact<int, TALLY_SUM, 1, 1>(compact_j32);
+      else eval_compact<int, TALLY_SUM, 1, 0>(compact_j32);
+    } else
+      eval_compact<int, TALLY_SUM, 0, 1>(compact_j32);
+  }
+}
 
-  evdwl = 0.0;
-  ev_init(eflag, vflag);
+/* ----------------------------------------------------------------------
+   dense kernel over the compact lists, plain entries with the global
+   scale as factor, then the special bond scaled entries
+------------------------------------------------------------------------- */
+
+template <typename IDX, int TALLY, int EFLAG, int VFLAG> void PairLJETEN::eval_compact(const IDX *cj)
+{
+  int i, j;
+  double xtmp, ytmp, ztmp;
+  Param *parami;
+  double evdwl = 0.0, esum = 0.0;
+  double vsum[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
 
   double **x = atom->x;
   double **f = atom->f;
   int *type = atom->type;
-  int nlocal = atom->nlocal;
-  double *special_lj = force->special_lj;
-  int newton_pair = force->newton_pair;
-
-  inum = list->inum;
-  ilist = list->ilist;
-  numneigh = list->numneigh;
-  firstneigh = list->firstneigh;
-
-  double cut_in_off = cut_respa[2];
-  double cut_in_on = cut_respa[3];
+  const int nlocal = atom->nlocal;
+  double special_lj[4];
+  scaled_special(special_lj);
+  const int newton_pair = force->newton_pair;
+
+  auto interact = [&](double factor_lj) {
+    const double delx = xtmp - x[j][0];
+    const double dely = ytmp - x[j][1];
+    const double delz = ztmp - x[j][2];
+    const double rsq = delx * delx + dely * dely + delz * delz;
+    const Param &p = parami[type[j]];
+    if (rsq >= p.cutsq) return;
+
+    const double r2inv = 1.0 / rsq;
+    const double r6inv = r2inv * r2inv * r2inv;
+    const double forcelj = r6inv * (p.lj1 * r6inv - p.lj2 * r2inv * r2inv + p.lj3);
+    const double fpair = factor_lj * forcelj * r2inv;
+
+    f[i][0] += delx * fpair;
+    f[i][1] += dely * fpair;
+    f[i][2] += delz * fpair;
+    if (newton_pair || j < nlocal) {
+      f[j][0] -= delx * fpair;
+      f[j][1] -= dely * fpair;
+      f[j][2] -= delz * fpair;
+    }
 
-  double cut_in_diff = cut_in_on - cut_in_off;
-  double cut_in_off_sq = cut_in_off * cut_in_off;
-  double cut_in_on_sq = cut_in_on * cut_in_on;
+    if (TALLY == TALLY_PAIR) {
+      if (eflag_either) evdwl = factor_lj * (r6inv * (p.lj4 * r6inv - p.lj5 * r2inv * r2inv + p.lj6) - p.offset);
+      ev_tally(i, j, nlocal, newton_pair, evdwl, 0.0, fpair, delx, dely, delz);
+    } else if (TALLY == TALLY_SUM) {
+      const double weight = (newton_pair || j < nlocal) ? 1.0 : 0.5;
+      if (EFLAG) esum += weight * factor_lj * (r6inv * (p.lj4 * r6inv - p.lj5 * r2inv * r2inv + p.lj6) - p.offset);
+      if (VFLAG) {
+        const double wf = weight * fpair;
+        vsum[0] += wf * delx * delx;
+        vsum[1] += wf * dely * dely;
+        vsum[2] += wf * delz * delz;
+        vsum[3] += wf * delx * dely;
+        vsum[4] += wf * delx * delz;
+        vsum[5] += wf * dely * delz;
+      }
+    }
+  };
 
-  // loop over neighbors of my atoms
+  const int inum = list->inum;
+  const int *ilist = list->ilist;
+  const double factor_plain = special_lj[0];
 
-  for (ii = 0; ii < inum; ii++) {
+  for (int ii = 0; ii < inum; ii++) {
     i = ilist[ii];
     xtmp = x[i][0];
     ytmp = x[i][1];
     ztmp = x[i][2];
-    itype = type[i];
-    jlist = firstneigh[i];
-    jnum = numneigh[i];
+    parami = params[type[i]];
+    const int last = compact_first[ii + 1];
+    for (int k = compact_first[ii]; k < last; k++) {
+      j = cj[k];
+      interact(factor_plain);
+    }
+  }
 
-    for (jj = 0; jj < jnum; jj++) {
-      j = jlist[jj];
-      factor_lj = special_lj[sbmask(j)];
-      j &= NEIGHMASK;
+  for (int k = 0; k < ncompact_special; k++) {
+    const CompactSpecial &sp = compact_special[k];
+    i = sp.i;
+    j = sp.j;
+    xtmp = x[i][0];
+    ytmp = x[i][1];
+    ztmp = x[i][2];
+    parami = params[type[i]];
+    interact(special_lj[sp.which]);
+  }
+
+  if (TALLY == TALLY_SUM) {
+    if (EFLAG) eng_vdwl += esum;
+    if (VFLAG)
+      for (int k = 0; k < 6; k++) virial[k] += vsum[k];
+  }
+}
+
+/* ----------------------------------------------------------------------
+   start a new replica in the same LAMMPS instance: coordinates may be
+   replaced and atoms reordered, coefficients and params stay valid
+------------------------------------------------------------------------- */
+
+void PairLJETEN::reset_replica()
+{
+  async_join();
+  async_armed = 0;
+
+  allpairs_stale = native_stale = compact_stale = 1;
+  qnative = 0.0;
+
+  stats_reset();
+  for (double &v : stats) v = 0.0;
+  for (int k = 0; k < nextra; k++) pvector[k] = 0.0;
+}
+
+/* ----------------------------------------------------------------------
+   let the next compute() run asynchronously, called right before the
+   force computation of an MD step only
+------------------------------------------------------------------------- */
+
+void PairLJETEN::async_arm()
+{
+  async_armed = (update->whichflag == 1) ? 1 : 0;
+}
+
+/* ----------------------------------------------------------------------
+   queue the dense kernel on the worker, return 0 if it has to run
+   synchronously because energy or virial is tallied on this step
+------------------------------------------------------------------------- */
 
-      delx = xtmp - x[j][0];
-      dely = ytmp - x[j][1];
-      delz = ztmp - x[j][2];
-      rsq = delx * delx + dely * dely + delz * delz;
-      jtype = type[j];
+int PairLJETEN::async_launch(int eflag, int vflag)
+{
+  ev_init(eflag, vflag);
 
-      if (rsq < cutsq[itype][jtype]) {
-        if (rsq > cut_in_off_sq) {
-          r2inv = 1.0 / rsq;
-          r6inv = r2inv * r2inv * r2inv;
-          forcelj = r6inv * (lj1[itype][jtype] * r6inv - lj2[itype][jtype] * r2inv * r2inv + lj3[itype][jtype]);
-          fpair = factor_lj * forcelj * r2inv;
-          if (rsq < cut_in_on_sq) {
-            rsw = (sqrt(rsq) - cut_in_off) / cut_in_diff;
-            fpair *= rsw * rsw * (3.0 - 2.0 * rsw);
-          }
+  // post_force fixes may read eng_vdwl and virial, e.g. fix plumed through
+  // compute pe, while the worker would still write them
 
-          f[i][0] += delx * fpair;
-          f[i][1] += dely * fpair;
-          f[i][2] += delz * fpair;
-          if (newton_pair || j < nlocal) {
-            f[j][0] -= delx * fpair;
-            f[j][1] -= dely * fpair;
-            f[j][2] -= delz * fpair;
-          }
-        }
+  if (eflag_either || vflag_either) return 0;
 
-        if (eflag) {
-          r2inv = 1.0 / rsq;
-          r6inv = r2inv * r2inv * r2inv;
-          evdwl = r6inv * (lj4[itype][jtype] * r6inv - lj5[itype][jtype] * r2inv * r2inv + lj6[itype][jtype]) - offset[itype][jtype];
-          evdwl *= factor_lj;
-        }
+  if (table_bits && table_stale) table_setup();
 
-        if (vflag) {
-          if (rsq <= cut_in_off_sq) {
-            r2inv = 1.0 / rsq;
-            r6inv = r2inv * r2inv * r2inv;
-            forcelj = r6inv * (lj1[itype][jtype] * r6inv - lj2[itype][jtype] * r2inv * r2inv + lj3[itype][jtype]);
-            fpair = factor_lj * forcelj * r2inv;
-          } else if (rsq < cut_in_on_sq)
-            fpair = factor_lj * forcelj * r2inv;
-        }
+  if (atom->nmax > nmax_async) {
+    memory->destroy(f_async);
+    nmax_async = atom->nmax;
+    memory->create(f_async, nmax_async, 3, "pair:f_async");
+  }
 
-        if (evflag) ev_tally(i, j, nlocal, newton_pair, evdwl, 0.0, fpair, delx, dely, delz);
-      }
-    }
+  if (!async->thread.joinable()) async->thread = std::thread(&PairLJETEN::async_run, this);
+  {
+    std::lock_guard<std::mutex> lock(async->mutex);
+    async->state = ASYNC_QUEUED;
   }
+  async->cv.notify_all();
+  async_pending = 1;
+  return 1;
 }
 
 /* ----------------------------------------------------------------------
-   allocate all arrays
+   worker loop: newton pair is off, so only owned atoms receive forces
+   and the buffer needs no reverse communication
 ------------------------------------------------------------------------- */
 
-void PairLJETEN::allocate()
+void PairLJETEN::async_run()
 {
-  allocated = 1;
-  int n = atom->ntypes + 1;
+  std::unique_lock<std::mutex> lock(async->mutex);
+  while (true) {
+    async->cv.wait(lock, [this] { return async->state == ASYNC_QUEUED || async->state == ASYNC_QUIT; });
+    if (async->state == ASYNC_QUIT) return;
+    lock.unlock();
 
-  memory->create(setflag, n, n, "pair:setflag");
-  for (int i = 1; i < n; i++)
-    for (int j = i; j < n; j++) setflag[i][j] = 0;
+    const int nlocal = atom->nlocal;
+    if (nlocal) memset(&f_async[0][0], 0, 3 * nlocal * sizeof(double));
 
-  memory->create(cutsq, n, n, "pair:cutsq");
+    if (table_bits) eval_dense_tally<1, 0>(f_async);
+    else eval_dense_tally<0, 0>(f_async);
 
-  memory->create(cut, n, n, "pair:cut");
-  memory->create(aterm, n, n, "pair:aterm");
-  memory->create(bterm, n, n, "pair:bterm");
-  memory->create(cterm, n, n, "pair:cterm");
-  memory->create(lj1, n, n, "pair:lj1");
-  memory->create(lj2, n, n, "pair:lj2");
-  memory->create(lj3, n, n, "pair:lj3");
-  memory->create(lj4, n, n, "pair:lj4");
-  memory->create(lj5, n, n, "pair:lj5");
-  memory->create(lj6, n, n, "pair:lj6");
-  memory->create(offset, n, n, "pair:offset");
+    lock.lock();
+    async->state = ASYNC_DONE;
+    async->cv.notify_all();
+  }
 }
 
 /* ----------------------------------------------------------------------
-   global settings
+   wait for the worker and add its forces, energy and virial are only
+   complete after this
 ------------------------------------------------------------------------- */
 
-void PairLJETEN::settings(int narg, char **arg)
+void PairLJETEN::async_join()
 {
-  if (narg != 1) error->all(FLERR, "Illegal pair_style command");
+  async_armed = 0;
+  if (!async_pending) return;
 
-  cut_global = utils::numeric(FLERR, arg[0], false, lmp);
+  {
+    std::unique_lock<std::mutex> lock(async->mutex);
+    async->cv.wait(lock, [this] { return async->state == ASYNC_DONE; });
+    async->state = ASYNC_IDLE;
+  }
+  async_pending = 0;
 
-  // reset cutoffs that have been explicitly set
+  double **f = atom->f;
+  const int nlocal = atom->nlocal;
+  for (int i = 0; i < nlocal; i++) {
+    f[i][0] += f_async[i][0];
+    f[i][1] += f_async[i][1];
+    f[i][2] += f_async[i][2];
+  }
+}
 
-  if (allocated) {
-    int i, j;
-    for (i = 1; i <= atom->ntypes; i++)
-      for (j = i; j <= atom->ntypes; j++)
-        if (setflag[i][j]) cut[i][j] = cut_global;
+/* ---------------------------------------------------------------------- */
+
+void PairLJETEN::async_stop()
+{
+  if (!async->thread.joinable()) return;
+  async_join();
+  {
+    std::lock_guard<std::mutex> lock(async->mutex);
+    async->state = ASYNC_QUIT;
   }
+  async->cv.notify_all();
+  async->thread.join();
 }
 
 /* ----------------------------------------------------------------------
-   set coeffs for one or more type pairs
+   tag native type pairs and build the global list of native atom pairs
 ------------------------------------------------------------------------- */
 
-void PairLJETEN::coeff(int narg, char **arg)
+void PairLJETEN::setup_native()
 {
-  if (narg < 5 || narg > 6) error->all(FLERR, "Incorrect args for pair coefficients");
-  if (!allocated) allocate();
+  if (atom->map_style == Atom::MAP_NONE)
+    error->all(FLERR, "Pair style lj/eten keyword native requires an atom map");
+  if (atom->map_tag_max != atom->natoms)
+    error->all(FLERR, "Pair style lj/eten keyword native requires consecutive atom IDs");
+  if (atom->natoms > MAXSMALLINT) error->all(FLERR, "Too many atoms for pair style lj/eten keyword native");
+
+  const int ntypes = atom->ntypes;
+  for (int i = 1; i <= ntypes; i++)
+    for (int j = i; j <= ntypes; j++)
+      native[i][j] = native[j][i] = (setflag[i][j] && (well_depth(i, j) > native_emin)) ? 1 : 0;
+
+  // atom types by atom ID, then atom IDs bucketed by type
+
+  const int natoms = atom->natoms;
+  int *typeone, *typeall;
+  memory->create(typeone, natoms + 1, "pair:typeone");
+  memory->create(typeall, natoms + 1, "pair:typeall");
+  for (int n = 0; n <= natoms; n++) typeone[n] = 0;
+  for (int i = 0; i < atom->nlocal; i++) typeone[atom->tag[i]] = atom->type[i];
+  MPI_Allreduce(typeone, typeall, natoms + 1, MPI_INT, MPI_MAX, world);
+
+  int *first, *next, *bytype;
+  memory->create(first, ntypes + 2, "pair:first");
+  memory->create(next, ntypes + 1, "pair:next");
+  memory->create(bytype, natoms, "pair:bytype");
+  for (int t = 0; t <= ntypes + 1; t++) first[t] = 0;
+  for (int n = 1; n <= natoms; n++) first[typeall[n] + 1]++;
+  for (int t = 1; t <= ntypes + 1; t++) first[t] += first[t - 1];
+  for (int t = 0; t <= ntypes; t++) next[t] = first[t];
+  for (int n = 1; n <= natoms; n++) bytype[next[typeall[n]]++] = n;
+
+  bigint count = 0;
+  for (int a = 1; a <= ntypes; a++)
+    for (int b = a; b <= ntypes; b++) {
+      if (!native[a][b]) continue;
+      const bigint na = first[a + 1] - first[a];
+      const bigint nb = first[b + 1] - first[b];
+      count += (a == b) ? na * (na - 1) / 2 : na * nb;
+    }
+  if (count > MAXSMALLINT) error->all(FLERR, "Too many native pairs for pair style lj/eten");
+
+  memory->destroy(native_tags);
+  memory->sfree(native_list);
+  nnative = count;
+  memory->create(native_tags, nnative + 1, 2, "pair:native_tags");
+
+  // with newton off a pair whose closest image is a ghost of an owned atom
+  // is listed from both ends
+
+  const bigint nlist = (force->newton_pair ? 1 : 2) * nnative + 1;
+  native_list = (NativePair *) memory->smalloc(sizeof(NativePair) * nlist, "pair:native_list");
+
+  int n = 0;
+  for (int a = 1; a <= ntypes; a++)
+    for (int b = a; b <= ntypes; b++) {
+      if (!native[a][b]) continue;
+      for (int ia = first[a]; ia < first[a + 1]; ia++)
+        for (int ib = (a == b) ? ia + 1 : first[b]; ib < first[b + 1]; ib++) {
+          native_tags[n][0] = MIN(bytype[ia], bytype[ib]);
+          native_tags[n][1] = MAX(bytype[ia], bytype[ib]);
+          n++;
+        }
+    }
 
-  int ilo, ihi, jlo, jhi;
-  utils::bounds(FLERR, arg[0], 1, atom->ntypes, ilo, ihi, error);
-  utils::bounds(FLERR, arg[1], 1, atom->ntypes, jlo, jhi, error);
+  memory->destroy(typeone);
+  memory->destroy(typeall);
+  memory->destroy(first);
+  memory->destroy(next);
+  memory->destroy(bytype);
+
+  if (comm->me == 0)
+    utils::logmesg(lmp, "  lj/eten native pairs: {} at cutoff {}, all others at {}\n", nnative,
+                   cut_global, cut_repulsive);
+  if (q_flag) setup_contacts();
+  if (qderiv_flag) grow_qderiv();
+  native_stale = 1;
+}
 
-  double aterm_one = utils::numeric(FLERR, arg[2], false, lmp);
-  double bterm_one = utils::numeric(FLERR, arg[3], false, lmp);
-  double cterm_one = utils::numeric(FLERR, arg[4], false, lmp);
+/* ----------------------------------------------------------------------
+   (re)allocate dQ/dx for atom->nmax atoms, zeroed
+------------------------------------------------------------------------- */
 
-  double cut_one = cut_global;
-  if (narg == 6) cut_one = utils::numeric(FLERR, arg[5], false, lmp);
+void PairLJETEN::grow_qderiv()
+{
+  if (atom->nmax <= nmax_qderiv) return;
+  nmax_qderiv = atom->nmax;
+  memory->destroy(qderiv);
+  memory->create(qderiv, nmax_qderiv, 3, "pair:qderiv");
+  for (int k = 0; k < nmax_qderiv; k++) qderiv[k][0] = qderiv[k][1] = qderiv[k][2] = 0.0;
+}
 
-  int count = 0;
-  for (int i = ilo; i <= ihi; i++) {
-    for (int j = MAX(jlo, i); j <= jhi; j++) {
-      aterm[i][j] = aterm_one;
-      bterm[i][j] = bterm_one;
-      cterm[i][j] = cterm_one;
-      cut[i][j] = cut_one;
-      setflag[i][j] = 1;
-      count++;
+/* ----------------------------------------------------------------------
+   read the Q contacts on proc 0, bcast. one "itag jtag r0 [weight]"
+   line per contact, # comments. a missing weight is 1/ncontact.
+------------------------------------------------------------------------- */
+
+void PairLJETEN::read_contact_file(const char *file)
+{
+  std::vector<tagint> tags;
+  std::vector<double> values;
+
+  if (comm->me == 0) {
+    FILE *fp = fopen(file, "r");
+    if (!fp) error->one(FLERR, "Cannot open lj/eten contact file {}: {}", file, utils::getsyserror());
+
+    char line[MAXLINE];
+    int nline = 0;
+    while (fgets(line, MAXLINE, fp)) {
+      nline++;
+      auto words = utils::split_words(utils::trim_comment(line));
+      if (words.empty()) continue;
+      if ((words.size() < 3) || (words.size() > 4) || !utils::is_integer(words[0]) ||
+          !utils::is_integer(words[1]) || !utils::is_double(words[2]) ||
+          ((words.size() == 4) && !utils::is_double(words[3])))
+        error->one(FLERR, "Invalid line {} in lj/eten contact file {}", nline, file);
+
+      tagint itag = utils::tnumeric(FLERR, words[0], false, lmp);
+      tagint jtag = utils::tnumeric(FLERR, words[1], false, lmp);
+      if (itag <= 0 || jtag <= 0 || itag == jtag)
+        error->one(FLERR, "Invalid atom IDs in line {} of lj/eten contact file {}", nline, file);
+      tags.push_back(MIN(itag, jtag));
+      tags.push_back(MAX(itag, jtag));
+      values.push_back(std::stod(words[2]));
+      values.push_back((words.size() == 4) ? std::stod(words[3]) : -1.0);
     }
+    fclose(fp);
+    if (values.empty()) error->one(FLERR, "No contacts in lj/eten contact file {}", file);
   }
 
-  if (count == 0) error->all(FLERR, "Incorrect args for pair coefficients");
+  int n = values.size() / 2;
+  MPI_Bcast(&n, 1, MPI_INT, 0, world);
+  tags.resize(2 * n);
+  values.resize(2 * n);
+  MPI_Bcast(tags.data(), 2 * n, MPI_LMP_TAGINT, 0, world);
+  MPI_Bcast(values.data(), 2 * n, MPI_DOUBLE, 0, world);
+
+  memory->destroy(contact_tags);
+  memory->destroy(contact_ref);
+  memory->destroy(contact_weight);
+  ncontact = n;
+  memory->create(contact_tags, ncontact, 2, "pair:contact_tags");
+  memory->create(contact_ref, ncontact, "pair:contact_ref");
+  memory->create(contact_weight, ncontact, "pair:contact_weight");
+  for (int c = 0; c < ncontact; c++) {
+    contact_tags[c][0] = tags[2 * c];
+    contact_tags[c][1] = tags[2 * c + 1];
+    contact_ref[c] = values[2 * c];
+    contact_weight[c] = (values[2 * c + 1] < 0.0) ? 1.0 / ncontact : values[2 * c + 1];
+  }
 }
 
 /* ----------------------------------------------------------------------
-   init specific to this pair style
+   attach the Q contacts to the global native pairs,
+   every contact must be a native pair
 ------------------------------------------------------------------------- */
 
-void PairLJETEN::init_style()
+void PairLJETEN::setup_contacts()
 {
-  // request regular or rRESPA neighbor list
-
-  int list_style = NeighConst::REQ_DEFAULT;
-
-  if (update->whichflag == 1 && utils::strmatch(update->integrate_style, "^respa")) {
-    auto respa = dynamic_cast<Respa *>(update->integrate);
-    if (respa->level_inner >= 0) list_style = NeighConst::REQ_RESPA_INOUT;
-    if (respa->level_middle >= 0) list_style = NeighConst::REQ_RESPA_ALL;
+  memory->destroy(native_qref);
+  memory->destroy(native_qweight);
+  memory->create(native_qref, nnative + 1, "pair:native_qref");
+  memory->create(native_qweight, nnative + 1, "pair:native_qweight");
+  for (int n = 0; n < nnative; n++) native_qref[n] = native_qweight[n] = 0.0;
+
+  const bigint stride = atom->natoms + 1;
+  std::unordered_map<bigint, int> index;
+  index.reserve(nnative);
+  for (int n = 0; n < nnative; n++) index[native_tags[n][0] * stride + native_tags[n][1]] = n;
+
+  for (int c = 0; c < ncontact; c++) {
+    auto found = index.find(contact_tags[c][0] * stride + contact_tags[c][1]);
+    if (found == index.end())
+      error->all(FLERR, "Pair style lj/eten Q contact {} {} is not a native pair", contact_tags[c][0],
+                 contact_tags[c][1]);
+    native_qref[found->second] = q_lambda * contact_ref[c];
+    native_qweight[found->second] = contact_weight[c];
   }
-  neighbor->add_request(this, list_style);
+}
 
-  // set rRESPA cutoffs
+/* ----------------------------------------------------------------------
+   select the native pairs this rank evaluates after reneighboring.
+   with newton off a pair is listed once for each owned end whose
+   partner is a ghost, so both ends receive their force, also when the
+   closest image of a local partner is a periodic ghost.
+------------------------------------------------------------------------- */
 
-  if (utils::strmatch(update->integrate_style, "^respa") &&
-      (dynamic_cast<Respa *>(update->integrate))->level_inner >= 0)
-    cut_respa = (dynamic_cast<Respa *>(update->integrate))->cutoff;
-  else
-    cut_respa = nullptr;
+void PairLJETEN::map_native()
+{
+  const int nlocal = atom->nlocal;
+  const int newton_pair = force->newton_pair;
+  int *type = atom->type;
+  double *special_lj = force->special_lj;
+
+  // add pair n with owned atom own and partner image other
+
+  auto add_native = [&](int n, int own, int other, tagint othertag) {
+    double factor_lj = 1.0;
+    if (atom->molecular != Atom::ATOMIC) {
+      const int *nspecial = atom->nspecial[own];
+      const tagint *special = atom->special[own];
+      for (int s = 0; s < nspecial[2]; s++)
+        if (special[s] == othertag) {
+          factor_lj = special_lj[(s < nspecial[0]) ? 1 : ((s < nspecial[1]) ? 2 : 3)];
+          break;
+        }
+    }
+    const double qweight = q_flag ? native_qweight[n] : 0.0;
+
+    // excluded pairs still count towards Q, as entries with no LJ force
+
+    if (factor_lj == 0.0 && qweight == 0.0) return;
+
+    NativePair &np = native_list[nnative_local++];
+    np.i = own;
+    np.j = other;
+    np.factor_lj = factor_lj;
+    np.cutsq = (factor_lj == 0.0) ? 0.0 : cut_eval[type[own]][type[other]] * cut_eval[type[own]][type[other]];
+    np.qref = q_flag ? native_qref[n] : 0.0;
+    np.qweight = qweight;
+  };
+
+  nnative_local = 0;
+  for (int n = 0; n < nnative; n++) {
+    const int i = atom->map(native_tags[n][0]);
+    const int j = atom->map(native_tags[n][1]);
+
+    // a partner beyond the ghost cutoff is beyond the pair cutoff as well
+
+    if (i < 0 || j < 0) continue;
+    if (i < nlocal) {
+      const int jimage = domain->closest_image(i, j);
+      add_native(n, i, jimage, native_tags[n][1]);
+      if (!newton_pair && (jimage >= nlocal) && (j < nlocal))
+        add_native(n, j, domain->closest_image(j, i), native_tags[n][0]);
+    } else if (!newton_pair && j < nlocal)
+      add_native(n, j, domain->closest_image(j, i), native_tags[n][0]);
+  }
+  native_stale = 0;
 }
 
 /* ----------------------------------------------------------------------
-   init for one type pair i,j and corresponding j,i
+   evaluate the static native pair list at the full cutoff
 ------------------------------------------------------------------------- */
 
-double PairLJETEN::init_one(int i, int j)
+void PairLJETEN::compute_native(int eflag)
 {
+  int i, j, itype, jtype;
+  double delx, dely, delz, evdwl, fpair;
+  double rsq, r2inv, r6inv, forcelj, factor_lj;
+  double qsum = 0.0;
 
-  if (setflag[i][j] == 0) {
-    aterm[i][j] = 0.0;
-    bterm[i][j] = 0.0;
-    cterm[i][j] = 0.0;
-    cut[i][j] = mix_distance(cut[i][i], cut[j][j]);
-  }
+  evdwl = 0.0;
 
-  aterm[i][j] = aterm[i][j];
-  bterm[i][j] = bterm[i][j];
-  cterm[i][j] = cterm[i][j];
+  // atoms are only reordered or migrated when neighbor lists are rebuilt
 
-  lj1[i][j] = 12.0 * aterm[i][j];
-  lj2[i][j] = 10.0 * bterm[i][j];
-  lj3[i][j] = 6.0 * cterm[i][j];
-  lj4[i][j] = aterm[i][j];
-  lj5[i][j] = bterm[i][j];
-  lj6[i][j] = cterm[i][j];
-
-  /*
-  if (offset_flag && (cut[i][j] > 0.0)) {
-    double sigma = sqrt( (18.0*aterm[i][j]) / (13.0*bterm[i][j]) );
-    double epsilon = aterm[i][j] / (13.0*pow(sigma,12.0));
-    double ratio = sigma / cut[i][j];
-    offset[i][j] = epsilon * (13.0*pow(ratio, 12.0) - 18.0*pow(ratio, 10.0) + 4.0*pow(ratio, 6.0));
-  } else */
-  offset[i][j] = 0.0;
-
-  lj1[j][i] = lj1[i][j];
-  lj2[j][i] = lj2[i][j];
-  lj3[j][i] = lj3[i][j];
-  lj4[j][i] = lj4[i][j];
-  lj5[j][i] = lj5[i][j];
-  lj6[j][i] = lj6[i][j];
-  offset[j][i] = offset[i][j];
+  if (neighbor->ago == 0 || native_stale) map_native();
 
-  // check interior rRESPA cutoff
+  double **x = atom->x;
+  double **f = atom->f;
+  int *type = atom->type;
+  int nlocal = atom->nlocal;
+  int newton_pair = force->newton_pair;
 
-  if (cut_respa && cut[i][j] < cut_respa[3])
-    error->all(FLERR, "Pair cutoff < Respa interior cutoff");
+  // dQ/dx is only accumulated and communicated once a consumer extracted it
 
-  // compute I,J contribution to long-range tail correction
-  // count total # of atoms of type I and J via Allreduce
+  const int qderiv_now = qderiv_flag && qderiv_request;
+  if (qderiv_now) {
+    const int nall = nlocal + atom->nghost;
+    grow_qderiv();
+    for (int k = 0; k < (newton_pair ? nall : nlocal); k++) qderiv[k][0] = qderiv[k][1] = qderiv[k][2] = 0.0;
+  }
 
-  if (tail_flag) { // Nico: sorry, no clue what this does, please don't use tail correction
-    int *type = atom->type; //Also there was a segmentation fault somewhere in here, it may have been from instantiating sigma and epsilon...so I personally wouldn't use restarts either...
-    int nlocal = atom->nlocal;
+  for (int n = 0; n < nnative_local; n++) {
+    const NativePair &np = native_list[n];
+    i = np.i;
+    j = np.j;
+    factor_lj = scale_kernel * np.factor_lj;
+
+    delx = x[i][0] - x[j][0];
+    dely = x[i][1] - x[j][1];
+    delz = x[i][2] - x[j][2];
+    rsq = delx * delx + dely * dely + delz * delz;
+
+    // contact switching function from the same distance, pairs listed
+    // from both ends with newton off count half
+
+    if (np.qweight != 0.0) {
+      const double r = sqrt(rsq);
+      const double sw = 1.0 / (1.0 + exp(q_beta * (r - np.qref)));
+      qsum += ((newton_pair || (j < nlocal)) ? 1.0 : 0.5) * np.qweight * sw;
+      if (qderiv_now) {
+        const double dqdr = -q_beta * sw * (1.0 - sw) * np.qweight / r;
+        if (newton_pair || i < nlocal) {
+          qderiv[i][0] += dqdr * delx;
+          qderiv[i][1] += dqdr * dely;
+          qderiv[i][2] += dqdr * delz;
+        }
+        if (newton_pair || j < nlocal) {
+          qderiv[j][0] -= dqdr * delx;
+          qderiv[j][1] -= dqdr * dely;
+          qderiv[j][2] -= dqdr * delz;
+        }
+      }
+    }
 
-    double count[2], all[2];
-    count[0] = count[1] = 0.0;
-    for (int k = 0; k < nlocal; k++) {
-      if (type[k] == i) count[0] += 1.0;
-      if (type[k] == j) count[1] += 1.0;
+    if (rsq < np.cutsq) {
+      itype = type[i];
+      jtype = type[j];
+      const Param &p = params[itype][jtype];
+      r2inv = 1.0 / rsq;
+      r6inv = r2inv * r2inv * r2inv;
+      forcelj = r6inv * (p.lj1 * r6inv - p.lj2 * r2inv * r2inv + p.lj3);
+      fpair = factor_lj * forcelj * r2inv;
+
+      if (newton_pair || i < nlocal) {
+        f[i][0] += delx * fpair;
+        f[i][1] += dely * fpair;
+        f[i][2] += delz * fpair;
+      }
+      if (newton_pair || j < nlocal) {
+        f[j][0] -= delx * fpair;
+        f[j][1] -= dely * fpair;
+        f[j][2] -= delz * fpair;
+      }
+
+      if (eflag) {
+        evdwl = r6inv * (p.lj4 * r6inv - p.lj5 * r2inv * r2inv + p.lj6) - p.offset;
+        evdwl *= factor_lj;
+      }
+
+      if (evflag) ev_tally(i, j, nlocal, newton_pair, evdwl, 0.0, fpair, delx, dely, delz);
     }
-    MPI_Allreduce(count, all, 2, MPI_DOUBLE, MPI_SUM, world);
+  }
 
-    double sig2 = aterm[i][j] * aterm[i][j];
-    double sig6 = sig2 * sig2 * sig2;
-    double rc3 = cut[i][j] * cut[i][j] * cut[i][j];
-    double rc6 = rc3 * rc3;
-    double rc9 = rc3 * rc6;
-    double prefactor = 8.0 * MY_PI * all[0] * all[1] * bterm[i][j] * sig6 / (9.0 * rc9);
-    etail_ij = prefactor * (sig6 - 3.0 * rc6);
-    ptail_ij = 2.0 * prefactor * (2.0 * sig6 - 3.0 * rc6);
+  // compute pair sums the per-rank partial Q in pvector across ranks,
+  // the global value is only reduced here when energy is tallied or
+  // once qnative was extracted
+
+  if (q_flag) {
+    pvector[0] = qsum;
+    if (eflag_global || q_request) MPI_Allreduce(&qsum, &qnative, 1, MPI_DOUBLE, MPI_SUM, world);
+    if (qderiv_now && newton_pair) comm->reverse_comm(this);
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+int PairLJETEN::pack_reverse_comm(int n, int first, double *buf)
+{
+  int m = 0;
+  int last = first + n;
+  for (int i = first; i < last; i++) {
+    buf[m++] = qderiv[i][0];
+    buf[m++] = qderiv[i][1];
+    buf[m++] = qderiv[i][2];
   }
+  return m;
+}
+
+/* ---------------------------------------------------------------------- */
 
-  return cut[i][j];
+void PairLJETEN::unpack_reverse_comm(int n, int *list, double *buf)
+{
+  int m = 0;
+  for (int i = 0; i < n; i++) {
+    int j = list[i];
+    qderiv[j][0] += buf[m++];
+    qderiv[j][1] += buf[m++];
+    qderiv[j][2] += buf[m++];
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -585,17 +2761,29 @@ void PairLJETEN::write_restart(FILE *fp)
 {
   write_restart_settings(fp);
 
-  int i, j;
-  for (i = 1; i <= atom->ntypes; i++)
-    for (j = i; j <= atom->ntypes; j++) {
-      fwrite(&setflag[i][j], sizeof(int), 1, fp);
-      if (setflag[i][j]) {
-        fwrite(&aterm[i][j], sizeof(double), 1, fp);
-        fwrite(&bterm[i][j], sizeof(double), 1, fp);
-	fwrite(&cterm[i][j], sizeof(double), 1, fp);
-        fwrite(&cut[i][j], sizeof(double), 1, fp);
-      }
+  // sparse mode stores the override list instead of a dense table
+
+  if (sparse_flag) {
+    fwrite(&noverride, sizeof(int), 1, fp);
+    std::vector<double> buf;
+    buf.reserve(6 * noverride);
+    for (int n = 0; n < noverride; n++) {
+      const Override &one = overrides[n];
+      buf.insert(buf.end(), {(double) one.i, (double) one.j, one.a, one.b, one.c, one.cut});
     }
+    fwrite(buf.data(), sizeof(double), buf.size(), fp);
+    return;
+  }
+
+  const int ncoeff = COEFF_PER_PAIR * atom->ntypes * (atom->ntypes + 1) / 2;
+  double *buf;
+  memory->create(buf, ncoeff, "pair:coeffbuf");
+  pack_coeff(buf);
+  fwrite(buf, sizeof(double), ncoeff, fp);
+  memory->destroy(buf);
+
+  if (residue_flag)
+    fwrite(res_coeff, sizeof(double), 2 * COEFF_PER_PAIR * nresidue * (nresidue + 1) / 2, fp);
 }
 
 /* ----------------------------------------------------------------------
@@ -607,25 +2795,34 @@ void PairLJETEN::read_restart(FILE *fp)
   read_restart_settings(fp);
   allocate();
 
-  int i, j;
-  int me = comm->me;
-  for (i = 1; i <= atom->ntypes; i++)
-    for (j = i; j <= atom->ntypes; j++) {
-      if (me == 0) utils::sfread(FLERR, &setflag[i][j], sizeof(int), 1, fp, nullptr, error);
-      MPI_Bcast(&setflag[i][j], 1, MPI_INT, 0, world);
-      if (setflag[i][j]) {
-        if (me == 0) {
-          utils::sfread(FLERR, &aterm[i][j], sizeof(double), 1, fp, nullptr, error);
-          utils::sfread(FLERR, &bterm[i][j], sizeof(double), 1, fp, nullptr, error);
-	  utils::sfread(FLERR, &cterm[i][j], sizeof(double), 1, fp, nullptr, error);
-          utils::sfread(FLERR, &cut[i][j], sizeof(double), 1, fp, nullptr, error);
-        }
-        MPI_Bcast(&aterm[i][j], 1, MPI_DOUBLE, 0, world);
-        MPI_Bcast(&bterm[i][j], 1, MPI_DOUBLE, 0, world);
-	MPI_Bcast(&cterm[i][j], 1, MPI_DOUBLE, 0, world);
-        MPI_Bcast(&cut[i][j], 1, MPI_DOUBLE, 0, world);
-      }
+  if (sparse_flag) {
+    int n = 0;
+    if (comm->me == 0) utils::sfread(FLERR, &n, sizeof(int), 1, fp, nullptr, error);
+    MPI_Bcast(&n, 1, MPI_INT, 0, world);
+    std::vector<double> buf(6 * n);
+    if (comm->me == 0) utils::sfread(FLERR, buf.data(), sizeof(double), buf.size(), fp, nullptr, error);
+    MPI_Bcast(buf.data(), buf.size(), MPI_DOUBLE, 0, world);
+    noverride = 0;
+    for (int k = 0; k < n; k++) {
+      const double *one = &buf[6 * k];
+      add_override((int) one[0], (int) one[1], one[2], one[3], one[4], one[5]);
     }
+    return;
+  }
+
+  const int ncoeff = COEFF_PER_PAIR * atom->ntypes * (atom->ntypes + 1) / 2;
+  double *buf;
+  memory->create(buf, ncoeff, "pair:coeffbuf");
+  if (comm->me == 0) utils::sfread(FLERR, buf, sizeof(double), ncoeff, fp, nullptr, error);
+  MPI_Bcast(buf, ncoeff, MPI_DOUBLE, 0, world);
+  unpack_coeff(buf);
+  memory->destroy(buf);
+
+  if (residue_flag) {
+    const int nres_coeff = 2 * COEFF_PER_PAIR * nresidue * (nresidue + 1) / 2;
+    if (comm->me == 0) utils::sfread(FLERR, res_coeff, sizeof(double), nres_coeff, fp, nullptr, error);
+    MPI_Bcast(res_coeff, nres_coeff, MPI_DOUBLE, 0, world);
+  }
 }
 
 /* ----------------------------------------------------------------------
@@ -634,10 +2831,39 @@ void PairLJETEN::read_restart(FILE *fp)
 
 void PairLJETEN::write_restart_settings(FILE *fp)
 {
+  fwrite(&LJETEN_RESTART_VERSION, sizeof(int), 1, fp);
   fwrite(&cut_global, sizeof(double), 1, fp);
   fwrite(&offset_flag, sizeof(int), 1, fp);
   fwrite(&mix_flag, sizeof(int), 1, fp);
   fwrite(&tail_flag, sizeof(int), 1, fp);
+  fwrite(&allpairs_flag, sizeof(int), 1, fp);
+  fwrite(&native_flag, sizeof(int), 1, fp);
+  fwrite(&cut_repulsive, sizeof(double), 1, fp);
+  fwrite(&native_emin, sizeof(double), 1, fp);
+  fwrite(&cut_tolerance, sizeof(double), 1, fp);
+  fwrite(&q_flag, sizeof(int), 1, fp);
+  if (q_flag) {
+    fwrite(&qderiv_flag, sizeof(int), 1, fp);
+    fwrite(&q_beta, sizeof(double), 1, fp);
+    fwrite(&q_lambda, sizeof(double), 1, fp);
+    fwrite(&ncontact, sizeof(int), 1, fp);
+    fwrite(&contact_tags[0][0], sizeof(tagint), 2 * ncontact, fp);
+    fwrite(contact_ref, sizeof(double), ncontact, fp);
+    fwrite(contact_weight, sizeof(double), ncontact, fp);
+  }
+  fwrite(&sparse_flag, sizeof(int), 1, fp);
+  fwrite(&sparse_a, sizeof(double), 1, fp);
+  fwrite(&sparse_cut, sizeof(double), 1, fp);
+  fwrite(&residue_flag, sizeof(int), 1, fp);
+  if (residue_flag) {
+    int n = strlen(residue_name) + 1;
+    fwrite(&nresidue, sizeof(int), 1, fp);
+    fwrite(&n, sizeof(int), 1, fp);
+    fwrite(residue_name, sizeof(char), n, fp);
+  }
+  fwrite(&table_bits, sizeof(int), 1, fp);
+  fwrite(&table_inner, sizeof(double), 1, fp);
+  fwrite(&isolated_flag, sizeof(int), 1, fp);
 }
 
 /* ----------------------------------------------------------------------
@@ -647,16 +2873,103 @@ void PairLJETEN::write_restart_settings(FILE *fp)
 void PairLJETEN::read_restart_settings(FILE *fp)
 {
   int me = comm->me;
+  int version = 0;
+  if (me == 0) utils::sfread(FLERR, &version, sizeof(int), 1, fp, nullptr, error);
+  MPI_Bcast(&version, 1, MPI_INT, 0, world);
+  if (version != LJETEN_RESTART_VERSION)
+    error->all(FLERR, "Pair style {} restart file format version {} does not match version {}",
+               force->pair_style, version, LJETEN_RESTART_VERSION);
+
   if (me == 0) {
     utils::sfread(FLERR, &cut_global, sizeof(double), 1, fp, nullptr, error);
     utils::sfread(FLERR, &offset_flag, sizeof(int), 1, fp, nullptr, error);
     utils::sfread(FLERR, &mix_flag, sizeof(int), 1, fp, nullptr, error);
     utils::sfread(FLERR, &tail_flag, sizeof(int), 1, fp, nullptr, error);
+    utils::sfread(FLERR, &allpairs_flag, sizeof(int), 1, fp, nullptr, error);
+    utils::sfread(FLERR, &native_flag, sizeof(int), 1, fp, nullptr, error);
+    utils::sfread(FLERR, &cut_repulsive, sizeof(double), 1, fp, nullptr, error);
+    utils::sfread(FLERR, &native_emin, sizeof(double), 1, fp, nullptr, error);
+    utils::sfread(FLERR, &cut_tolerance, sizeof(double), 1, fp, nullptr, error);
   }
   MPI_Bcast(&cut_global, 1, MPI_DOUBLE, 0, world);
   MPI_Bcast(&offset_flag, 1, MPI_INT, 0, world);
   MPI_Bcast(&mix_flag, 1, MPI_INT, 0, world);
   MPI_Bcast(&tail_flag, 1, MPI_INT, 0, world);
+  MPI_Bcast(&allpairs_flag, 1, MPI_INT, 0, world);
+  MPI_Bcast(&native_flag, 1, MPI_INT, 0, world);
+  MPI_Bcast(&cut_repulsive, 1, MPI_DOUBLE, 0, world);
+  MPI_Bcast(&native_emin, 1, MPI_DOUBLE, 0, world);
+  MPI_Bcast(&cut_tolerance, 1, MPI_DOUBLE, 0, world);
+
+  if (me == 0) utils::sfread(FLERR, &q_flag, sizeof(int), 1, fp, nullptr, error);
+  MPI_Bcast(&q_flag, 1, MPI_INT, 0, world);
+  if (q_flag) {
+    if (me == 0) {
+      utils::sfread(FLERR, &qderiv_flag, sizeof(int), 1, fp, nullptr, error);
+      utils::sfread(FLERR, &q_beta, sizeof(double), 1, fp, nullptr, error);
+      utils::sfread(FLERR, &q_lambda, sizeof(double), 1, fp, nullptr, error);
+      utils::sfread(FLERR, &ncontact, sizeof(int), 1, fp, nullptr, error);
+    }
+    MPI_Bcast(&qderiv_flag, 1, MPI_INT, 0, world);
+    MPI_Bcast(&q_beta, 1, MPI_DOUBLE, 0, world);
+    MPI_Bcast(&q_lambda, 1, MPI_DOUBLE, 0, world);
+    MPI_Bcast(&ncontact, 1, MPI_INT, 0, world);
+    memory->destroy(contact_tags);
+    memory->destroy(contact_ref);
+    memory->destroy(contact_weight);
+    memory->create(contact_tags, ncontact, 2, "pair:contact_tags");
+    memory->create(contact_ref, ncontact, "pair:contact_ref");
+    memory->create(contact_weight, ncontact, "pair:contact_weight");
+    if (me == 0) {
+      utils::sfread(FLERR, &contact_tags[0][0], sizeof(tagint), 2 * ncontact, fp, nullptr, error);
+      utils::sfread(FLERR, contact_ref, sizeof(double), ncontact, fp, nullptr, error);
+      utils::sfread(FLERR, contact_weight, sizeof(double), ncontact, fp, nullptr, error);
+    }
+    MPI_Bcast(&contact_tags[0][0], 2 * ncontact, MPI_LMP_TAGINT, 0, world);
+    MPI_Bcast(contact_ref, ncontact, MPI_DOUBLE, 0, world);
+    MPI_Bcast(contact_weight, ncontact, MPI_DOUBLE, 0, world);
+    nextra = 1;
+    if (!pvector) pvector = new double[1];
+    pvector[0] = 0.0;
+    comm_reverse = qderiv_flag ? 3 : 0;
+  }
+
+  if (me == 0) {
+    utils::sfread(FLERR, &sparse_flag, sizeof(int), 1, fp, nullptr, error);
+    utils::sfread(FLERR, &sparse_a, sizeof(double), 1, fp, nullptr, error);
+    utils::sfread(FLERR, &sparse_cut, sizeof(double), 1, fp, nullptr, error);
+  }
+  MPI_Bcast(&sparse_flag, 1, MPI_INT, 0, world);
+  MPI_Bcast(&sparse_a, 1, MPI_DOUBLE, 0, world);
+  MPI_Bcast(&sparse_cut, 1, MPI_DOUBLE, 0, world);
+  if (sparse_flag) writedata = 0;
+
+  if (me == 0) utils::sfread(FLERR, &residue_flag, sizeof(int), 1, fp, nullptr, error);
+  MPI_Bcast(&residue_flag, 1, MPI_INT, 0, world);
+  if (residue_flag) {
+    int n = 0;
+    if (me == 0) {
+      utils::sfread(FLERR, &nresidue, sizeof(int), 1, fp, nullptr, error);
+      utils::sfread(FLERR, &n, sizeof(int), 1, fp, nullptr, error);
+    }
+    MPI_Bcast(&nresidue, 1, MPI_INT, 0, world);
+    MPI_Bcast(&n, 1, MPI_INT, 0, world);
+    delete[] residue_name;
+    residue_name = new char[n];
+    if (me == 0) utils::sfread(FLERR, residue_name, sizeof(char), n, fp, nullptr, error);
+    MPI_Bcast(residue_name, n, MPI_CHAR, 0, world);
+    allocate_residue();
+    writedata = 0;
+  }
+
+  if (me == 0) {
+    utils::sfread(FLERR, &table_bits, sizeof(int), 1, fp, nullptr, error);
+    utils::sfread(FLERR, &table_inner, sizeof(double), 1, fp, nullptr, error);
+    utils::sfread(FLERR, &isolated_flag, sizeof(int), 1, fp, nullptr, error);
+  }
+  MPI_Bcast(&table_bits, 1, MPI_INT, 0, world);
+  MPI_Bcast(&table_inner, 1, MPI_DOUBLE, 0, world);
+  MPI_Bcast(&isolated_flag, 1, MPI_INT, 0, world);
 }
 
 /* ----------------------------------------------------------------------
@@ -681,43 +2994,184 @@ void PairLJETEN::write_data_all(FILE *fp)
 
 /* ---------------------------------------------------------------------- */
 
-double PairLJETEN::single(int /*i*/, int /*j*/, int itype, int jtype, double rsq,
+double PairLJETEN::single(int i, int j, int itype, int jtype, double rsq,
                          double /*factor_coul*/, double factor_lj, double &fforce)
 {
   double r2inv, r6inv, forcelj, philj;
+  const Param &p = lookup_param(i, j, itype, jtype);
 
+  factor_lj *= scale_kernel;
   r2inv = 1.0 / rsq;
   r6inv = r2inv * r2inv * r2inv;
-  forcelj = r6inv * (lj1[itype][jtype] * r6inv - lj2[itype][jtype] * r2inv * r2inv + lj3[itype][jtype]);
+  forcelj = r6inv * (p.lj1 * r6inv - p.lj2 * r2inv * r2inv + p.lj3);
   fforce = factor_lj * forcelj * r2inv;
 
-  philj = r6inv * (lj4[itype][jtype] * r6inv - lj5[itype][jtype] * r2inv * r2inv + lj6[itype][jtype]) - offset[itype][jtype];
+  philj = r6inv * (p.lj4 * r6inv - p.lj5 * r2inv * r2inv + p.lj6) - p.offset;
   return factor_lj * philj;
 }
 
+/* ----------------------------------------------------------------------
+   single() for n pairs given by their types, squared distances and
+   special factors, without the virtual call per pair. like single() the
+   caller is responsible for the cutoff test. fforce may be null.
+   residue mode needs the atoms of a pair and is not supported.
+------------------------------------------------------------------------- */
+
+void PairLJETEN::single_batch(int n, const int *itype, const int *jtype, const double *rsq,
+                              const double *factor_lj, double *energy, double *fforce)
+{
+  if (residue_flag) error->all(FLERR, "Pair style lj/eten keyword residue does not support single_batch()");
+
+  for (int k = 0; k < n; k++) {
+    const Param &p = sparse_flag ? sparse_param(itype[k], jtype[k]) : params[itype[k]][jtype[k]];
+    const double factor = scale_kernel * factor_lj[k];
+    const double r2inv = 1.0 / rsq[k];
+    const double r4inv = r2inv * r2inv;
+    const double r6inv = r4inv * r2inv;
+    energy[k] = factor * (r6inv * (p.lj4 * r6inv - p.lj5 * r4inv + p.lj6) - p.offset);
+    if (fforce) fforce[k] = factor * r6inv * (p.lj1 * r6inv - p.lj2 * r4inv + p.lj3) * r2inv;
+  }
+}
+
 /* ---------------------------------------------------------------------- */
 
-void PairLJETEN::born_matrix(int /*i*/, int /*j*/, int itype, int jtype, double rsq,
+void PairLJETEN::born_matrix(int i, int j, int itype, int jtype, double rsq,
                             double /*factor_coul*/, double factor_lj, double &dupair,
                             double &du2pair)
 {
-  double rinv, r2inv, r6inv, du, du2;
+  double rinv, r2inv, r4inv, r6inv, du, du2;
 
   r2inv = 1.0 / rsq;
   rinv = sqrt(r2inv);
-  r6inv = r2inv * r2inv * r2inv;
+  r4inv = r2inv * r2inv;
+  r6inv = r4inv * r2inv;
+
+  // U = A/r^12 - B/r^10 + C/r^6 with lj1 = 12A, lj2 = 10B, lj3 = 6C
+  // dU/dr = -12A/r^13 + 10B/r^11 - 6C/r^7
+  // d2U/dr2 = 156A/r^14 - 110B/r^12 + 42C/r^8
+
+  const Param &p = lookup_param(i, j, itype, jtype);
+  du = r6inv * rinv * (p.lj2 * r4inv - p.lj1 * r6inv - p.lj3);
+  du2 = r6inv * r2inv * (13.0 * p.lj1 * r6inv - 11.0 * p.lj2 * r4inv + 7.0 * p.lj3);
+
+  dupair = scale_kernel * factor_lj * du;
+  du2pair = scale_kernel * factor_lj * du2;
+}
+
+/* ----------------------------------------------------------------------
+   derive parameter set s of nset into table. type pairs flagged in the
+   dense coefficient buffer coeff (may be null) use its A, B, C, all
+   others the current ones, then A, B, C are multiplied by scale[0..2]
+   and the global scale of the pair style.
+   cutoffs stay those of the current parameters, offsets are recomputed.
+------------------------------------------------------------------------- */
+
+void PairLJETEN::energy_set_params(const double *coeff, const double *scale, int nset, int s,
+                                   Param **table)
+{
+  const int ntypes = atom->ntypes;
+  const double *one = coeff;
+
+  for (int i = 1; i <= ntypes; i++)
+    for (int j = i; j <= ntypes; j++) {
+      const bool fromfile = one && (one[0] != 0.0);
+      Param p = params[i][j];
+      p.lj4 = scale_global * scale[0] * (fromfile ? one[1] : aterm[i][j]);
+      p.lj5 = scale_global * scale[1] * (fromfile ? one[2] : bterm[i][j]);
+      p.lj6 = scale_global * scale[2] * (fromfile ? one[3] : cterm[i][j]);
+      p.lj1 = 12.0 * p.lj4;
+      p.lj2 = 10.0 * p.lj5;
+      p.lj3 = 6.0 * p.lj6;
+      if (one) one += COEFF_PER_PAIR;
+
+      const double rc = (native_flag && native[i][j]) ? cut_eval[i][j] : sqrt(p.cutsq);
+      p.offset = 0.0;
+      if (offset_flag && (rc > 0.0)) {
+        double rc2inv = 1.0 / (rc * rc);
+        double rc6inv = rc2inv * rc2inv * rc2inv;
+        p.offset = rc6inv * (p.lj4 * rc6inv - p.lj5 * rc2inv * rc2inv + p.lj6);
+      }
+      table[i][j * nset + s] = table[j][i * nset + s] = p;
+    }
+}
 
-  // Reminder: lj1 = 48*e*s^12, lj2 = 24*e*s^6
-  // so dupair = -forcelj/r = -fforce*r (forcelj from single method)
+/* ----------------------------------------------------------------------
+   energy of this rank under the nset parameter sets of table, in one
+   sweep over the pairs compute() evaluates. powers of r are shared by
+   all sets, pairs with a ghost atom count half with newton off.
+------------------------------------------------------------------------- */
+
+void PairLJETEN::compute_energy_sets(int nset, Param **table, double *energy)
+{
+  double **x = atom->x;
+  int *type = atom->type;
+  int nlocal = atom->nlocal;
+  double *special_lj = force->special_lj;
+  int newton_pair = force->newton_pair;
 
-  // Except not for the Karanicolas/Brooks potential, so please don't use the Born matrix.
-  // Implicit solvent doesn't exist anyway. ~Nico
+  for (int s = 0; s < nset; s++) energy[s] = 0.0;
+
+  auto tally = [&](int itype, int jtype, double rsq, double weight) {
+    const double r2inv = 1.0 / rsq;
+    const double r4inv = r2inv * r2inv;
+    const double r6inv = r4inv * r2inv;
+    const double r12inv = r6inv * r6inv;
+    const double r10inv = r6inv * r4inv;
+    const Param *p = table[itype] + jtype * nset;
+    for (int s = 0; s < nset; s++)
+      energy[s] += weight * (p[s].lj4 * r12inv - p[s].lj5 * r10inv + p[s].lj6 * r6inv - p[s].offset);
+  };
+
+  if (allpairs_flag) {
+    if (allpairs_stale) map_allpairs();
+    for (int n = 0; n < npair_all; n++) {
+      const AllPair &ap = allpairs[n];
+      const double delx = x[ap.i][0] - x[ap.jimage][0];
+      const double dely = x[ap.i][1] - x[ap.jimage][1];
+      const double delz = x[ap.i][2] - x[ap.jimage][2];
+      const double rsq = delx * delx + dely * dely + delz * delz;
+      if (rsq < params[type[ap.i]][type[ap.j]].cutsq) tally(type[ap.i], type[ap.j], rsq, ap.factor_lj);
+    }
+    return;
+  }
 
-  du = r6inv * rinv * (lj2[itype][jtype] - lj1[itype][jtype] * r6inv);
-  du2 = r6inv * r2inv * (13 * lj1[itype][jtype] * r6inv - 7 * lj2[itype][jtype]);
+  const int inum = list->inum;
+  const int *ilist = list->ilist;
+  const int *numneigh = list->numneigh;
+  int **firstneigh = list->firstneigh;
+
+  for (int ii = 0; ii < inum; ii++) {
+    const int i = ilist[ii];
+    const int itype = type[i];
+    const Param *parami = params[itype];
+    const int *jlist = firstneigh[i];
+    const int jnum = numneigh[i];
+
+    for (int jj = 0; jj < jnum; jj++) {
+      const double factor_lj = special_lj[sbmask(jlist[jj])];
+      const int j = jlist[jj] & NEIGHMASK;
+      const double delx = x[i][0] - x[j][0];
+      const double dely = x[i][1] - x[j][1];
+      const double delz = x[i][2] - x[j][2];
+      const double rsq = delx * delx + dely * dely + delz * delz;
+      const int jtype = type[j];
+      if (rsq < parami[jtype].cutsq)
+        tally(itype, jtype, rsq, (newton_pair || j < nlocal) ? factor_lj : 0.5 * factor_lj);
+    }
+  }
 
-  dupair = factor_lj * du;
-  du2pair = factor_lj * du2;
+  if (native_flag) {
+    if (native_stale) map_native();
+    for (int n = 0; n < nnative_local; n++) {
+      const NativePair &np = native_list[n];
+      const double delx = x[np.i][0] - x[np.j][0];
+      const double dely = x[np.i][1] - x[np.j][1];
+      const double delz = x[np.i][2] - x[np.j][2];
+      const double rsq = delx * delx + dely * dely + delz * delz;
+      if (rsq < np.cutsq)
+        tally(type[np.i], type[np.j], rsq, (newton_pair || np.j < nlocal) ? np.factor_lj : 0.5 * np.factor_lj);
+    }
+  }
 }
 
 /* ---------------------------------------------------------------------- */
@@ -728,5 +3182,44 @@ void *PairLJETEN::extract(const char *str, int &dim)
   if (strcmp(str, "aterm") == 0) return (void *) aterm;
   if (strcmp(str, "bterm") == 0) return (void *) bterm;
   if (strcmp(str, "cterm") == 0) return (void *) cterm;
+  if (strcmp(str, "scale") == 0) {
+    dim = 0;
+    return (void *) &scale_global;
+  }
+  if (q_flag && strcmp(str, "qnative") == 0) {
+    dim = 0;
+    q_request = 1;
+    return (void *) &qnative;
+  }
+  if (qderiv_flag && strcmp(str, "qnative_deriv_nmax") == 0) {
+    dim = 0;
+    return (void *) &nmax_qderiv;
+  }
+  if (stats_flag) {
+    static const char *names[NSTATS] = {"stats_visited", "stats_inside", "stats_special",
+                                        "stats_calls", "stats_time", "stats_time_inner",
+                                        "stats_time_middle", "stats_time_outer"};
+    for (int k = 0; k < NSTATS; k++)
+      if (strcmp(str, names[k]) == 0) {
+        dim = 0;
+        return (void *) &stats[k];
+      }
+  }
+  return nullptr;
+}
+
+/* ----------------------------------------------------------------------
+   dQ/dx of the owned atoms from the last force evaluation. the array is
+   reallocated when atom->nmax grows, consumers compare the extracted
+   qnative_deriv_nmax and extract it again when it changed.
+------------------------------------------------------------------------- */
+
+void *PairLJETEN::extract_peratom(const char *str, int &ncol)
+{
+  if (qderiv_flag && strcmp(str, "qnative_deriv") == 0) {
+    ncol = 3;
+    qderiv_request = 1;
+    return (void *) qderiv;
+  }
   return nullptr;
 }
@@ -22,6 +22,10 @@ PairStyle(lj/eten,PairLJETEN);
 
 #include "pair.h"
 
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
 namespace LAMMPS_NS {
 
 class PairLJETEN : public Pair {
@@ -31,8 +35,11 @@ class PairLJETEN : public Pair {
   void compute(int, int) override;
   void settings(int, char **) override;
   void coeff(int, char **) override;
+  void modify_params(int, char **) override;
   void init_style() override;
   double init_one(int, int) override;
+  void setup() override;
+  void reinit() override;
   void write_restart(FILE *) override;
   void read_restart(FILE *) override;
   void write_restart_settings(FILE *) override;
@@ -41,20 +48,292 @@ class PairLJETEN : public Pair {
   void write_data_all(FILE *) override;
   double single(int, int, int, int, double, double, double, double &) override;
   void born_matrix(int, int, int, int, double, double, double, double &, double &) override;
+  virtual void single_batch(int, const int *, const int *, const double *, const double *, double *,
+                            double *);
   void *extract(const char *, int &) override;
+  void *extract_peratom(const char *, int &) override;
+  int pack_reverse_comm(int, int, double *) override;
+  void unpack_reverse_comm(int, int *, double *) override;
 
   void compute_inner() override;
   void compute_middle() override;
   void compute_outer(int, int) override;
 
+  // derived per type pair parameters, packed into one 64-byte record
+  // so that a pair evaluation touches a single cache line
+
+  struct Param {
+    double cutsq, lj1, lj2, lj3, lj4, lj5, lj6, offset;
+  };
+
+  // doubles per type pair in coefficient buffers: setflag, A, B, C, cut
+
+  static constexpr int COEFF_PER_PAIR = 5;
+
+  // energies of the current configuration under alternative coefficient
+  // sets, with the cutoffs and pair selection of the current ones. set s
+  // of nset is stored for type pair i,j at table[i][j*nset+s].
+
+  void load_coeff_file(const char *, double, double, double *, std::vector<double> &);
+  void energy_set_params(const double *, const double *, int, int, Param **);
+  void compute_energy_sets(int, Param **, double *);
+  virtual bool energy_sets_supported() const { return !residue_flag && !sparse_flag; }
+
+  // async mode: the dense kernel of an MD step runs on a worker thread
+  // into its own force buffer, armed by and joined in the internal fix
+  // LJ_ETEN_JOIN after all other post_force fixes (e.g. fix plumed)
+
+  void async_arm();
+  void async_join();
+
+  // library mode replica drivers: forget the per-trajectory state
+  // (statistics, atom maps, pending async work) while keeping the
+  // coefficient and derived parameter tables, also as pair_modify reset
+
+  void reset_replica();
+
  protected:
   double cut_global;
   double **cut;
+  double **cut_eval;    // cutoff in effect after tolerance tightening
   double **aterm, **bterm, **cterm;
-  double **lj1, **lj2, **lj3, **lj4, **lj5, **lj6, **offset;
+  Param **params;
   double *cut_respa;
 
+  // neighbor list free mode: a fixed list of interacting atom pairs,
+  // i and j are local indices, jimage the image of j closest to i
+
+  struct AllPair {
+    tagint itag, jtag;
+    int i, j, jimage;
+    double factor_lj;
+  };
+
+  int allpairs_flag;
+  int npair_all;
+  int isolated_flag;    // allpairs without images and ghost cutoff
+  int allpairs_stale;
+  AllPair *allpairs;
+
+  // native mode: type pairs with a well depth above native_emin are
+  // evaluated from a static list of atom pairs, all other type pairs
+  // use the neighbor list with the shorter cut_repulsive
+
+  struct NativePair {
+    int i, j;
+    double factor_lj, cutsq;
+    double qref, qweight;    // lambda*r0 and weight if a Q contact
+  };
+
+  int native_flag;
+  double cut_repulsive, native_emin;
+  int **native;
+  int nnative;                // global native atom pairs
+  tagint **native_tags;
+  int nnative_local;          // native pairs evaluated by this rank
+  int native_stale;
+  NativePair *native_list;
+
+  // fused native contact fraction, accumulated over the native list:
+  // Q = sum_c w_c / (1 + exp(beta (r_c - lambda r0_c))) for the contacts
+  // of the contact file, optionally with dQ/dx of every owned atom
+
+  int q_flag, qderiv_flag;
+  double q_beta, q_lambda;
+  int ncontact;
+  tagint **contact_tags;
+  double *contact_ref, *contact_weight;
+  double *native_qref, *native_qweight;    // per global native pair
+  double qnative;    // global Q, reduced on energy steps or once extracted
+  int q_request, qderiv_request;
+
+  // qderiv is allocated by init_style() and grows with atom->nmax.
+  // consumers must extract it again whenever qnative_deriv_nmax changed.
+
+  int nmax_qderiv;
+  double **qderiv;
+
+  void grow_qderiv();
+
+  // pair_modify tolerance: shortest cutoff beyond which |U| and |F|
+  // stay below cut_tolerance, with statistics for the setup report,
+  // collected from init_style() until setup()
+
+  double cut_tolerance;
+  int tol_pending;
+  int tol_count, tol_tightened;
+  double tol_min, tol_max, tol_sum;
+  int tol_histo[10];
+
+  // residue mode: parameters are looked up by the per-atom residue
+  // index from a custom integer property and by whether both atoms
+  // share a molecule ID, in tables of nresidue x nresidue entries
+  // shared by all chains. res_coeff holds the packed raw coefficients
+  // of the inter (0) and intra (1) chain table.
+
+  int residue_flag;
+  char *residue_name;
+  int residue_index;
+  int nresidue;
+  double *res_coeff;
+  Param ***res_params;    // [intra][ri][rj]
+  double res_cutmax;
+
+  // sparse mode: all type pairs use the repulsive default sparse_a/r^12
+  // within sparse_cut, except for explicitly set overrides. overrides
+  // are collected from pair_coeff and stored in CSR form, jtypes sorted
+  // per itype, instead of the dense coefficient and parameter tables.
+  // setflag and cutsq, which Pair and the neighbor lists index by type
+  // pair, remain (ntypes+1)^2 arrays, the dense pointers stay null.
+
+  struct Override {
+    int i, j;
+    double a, b, c, cut;
+  };
+
+  int sparse_flag;
+  double sparse_a, sparse_cut;
+  int noverride, maxoverride;
+  Override *overrides;
+  int *sparse_first;     // row offsets, ntypes+2
+  int *sparse_jtype;
+  Param *sparse_params;
+  Param sparse_default;
+
+  const Param &sparse_param(int itype, int jtype) const
+  {
+    const int *first = sparse_jtype + sparse_first[itype];
+    const int *last = sparse_jtype + sparse_first[itype + 1];
+    const int *k = std::lower_bound(first, last, jtype);
+    return ((k != last) && (*k == jtype)) ? sparse_params[k - sparse_jtype] : sparse_default;
+  }
+
+  // global energy scale, adaptable as "scale". styles whose kernels
+  // apply it through the special bond factors use scale_kernel, all
+  // others fold it into params as scale_param.
+
+  int scale_in_kernel;
+  double scale_global, scale_kernel, scale_param;
+
+  void update_scale();
+  void scaled_special(double *) const;
+
+  // coefficients each params entry was last derived from, so that
+  // reinit() only recomputes type pairs that were changed since
+
+  struct CoeffInit {
+    double a, b, c;
+  };
+
+  CoeffInit **coeff_init;
+  int reinit_partial;
+
+  // optional hot path statistics, summed over the run and all ranks:
+  // neighbor list entries visited, entries inside the cutoff, special
+  // bond scaled entries inside the cutoff, calls of compute() and mean
+  // wall time per rank spent in compute() and each rRESPA level
+
+  enum { STAT_VISITED, STAT_INSIDE, STAT_SPECIAL, STAT_CALLS, STAT_TIME,
+         STAT_TIME_INNER, STAT_TIME_MIDDLE, STAT_TIME_OUTER, NSTATS };
+
+  int stats_flag;
+  double stats_local[NSTATS];
+  double stats[NSTATS];
+
+  void stats_reset();
+  void stats_reduce();
+
+  // async and allpairs tally the virial explicitly for the runs they are
+  // used in, the style's own no_virial_fdotr_compute is restored on init
+
+  int fdotr_forced, fdotr_saved;
+  void force_explicit_virial();
+
+  struct AsyncWorker;
+
+  int async_flag;
+  int async_armed, async_pending;
+  AsyncWorker *async;
+  int nmax_async;
+  double **f_async;
+
+  int async_launch(int, int);
+  void async_run();
+  void async_stop();
+
+  // tabulated mode, pair_modify table/lj: fpair and energy of single()
+  // with factor_lj = 1 as cubic segments in rsq, indexed by the exponent
+  // and leading table_bits mantissa bits of rsq as a float, from
+  // table_inner to the cutoff. type pairs with identical parameter
+  // records share one table, table_offset is -1 without table.
+
+  struct TableSeg {
+    double f0, f1, f2, f3, e0, e1, e2, e3;
+  };
+
+  int table_bits;
+  double table_inner, table_innersq;
+  int table_stale, table_report;
+  int table_shift, table_base;
+  int **table_offset;
+  TableSeg *table_segs;
+
+  void table_setup();
+
+  // compact mode: after each neighbor list build the list is copied to
+  // CSR form without special bits, as 16-bit indices when all owned and
+  // ghost atoms fit. special bond scaled entries are kept separately,
+  // entries with a zero special factor are dropped.
+
+  struct CompactSpecial {
+    int i, j, which;
+  };
+
+  int compact_flag;
+  int compact_stale;
+  int compact_short;
+  int max_compact_first, max_compact, max_compact_special;
+  int ncompact_special;
+  int *compact_first;
+  uint16_t *compact_j16;
+  int *compact_j32;
+  CompactSpecial *compact_special;
+
+  void compact_build();
+  void eval_compact_tally();
+  template <typename IDX, int TALLY, int EFLAG, int VFLAG> void eval_compact(const IDX *);
+
   virtual void allocate();
+  void deallocate();
+  template <int STATS> void eval(int, int);
+  template <int TABLE, int STATS> void eval_dense_tally(double **);
+  template <int TABLE, int TALLY, int EFLAG, int VFLAG, int STATS> void eval_dense(double **);
+  template <int N1, int N2, int N3, int LEVEL, int EVFLAG, int EFLAG, int VFLAG, int STATS>
+  void eval_respa();
+  double well_depth(int, int);
+  double tolerance_cutoff(int, int, double);
+  void read_coeff_file(const char *, double, double);
+  void pack_coeff(double *);
+  int unpack_coeff(const double *);
+  int unpack_residue(const double *);
+  void allocate_residue();
+  void setup_residue();
+  template <int STATS> void compute_residue(int, int);
+  const Param &lookup_param(int, int, int, int);
+  void add_override(int, int, double, double, double, double);
+  void setup_sparse();
+  double init_one_sparse(int, int);
+  template <int EVFLAG, int EFLAG, int NEWTON_PAIR, int STATS> void eval_sparse();
+  void tolerance_report(double);
+  void setup_allpairs();
+  void map_allpairs();
+  void check_isolated();
+  void compute_allpairs(int, int);
+  void setup_native();
+  void read_contact_file(const char *);
+  void setup_contacts();
+  void map_native();
+  void compute_native(int);
 };
 
 }    // namespace LAMMPS_NS
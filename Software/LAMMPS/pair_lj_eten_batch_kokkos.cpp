@@ -0,0 +1,430 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#include "pair_lj_eten_batch_kokkos.h"
+
+#include "atom_kokkos.h"
+#include "atom_masks.h"
+#include "comm.h"
+#include "domain.h"
+#include "error.h"
+#include "force.h"
+#include "kokkos.h"
+#include "memory_kokkos.h"
+#include "neighbor.h"
+#include "respa.h"
+#include "update.h"
+
+#include <cmath>
+#include <cstring>
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType>
+PairLJETENBatchKokkos<DeviceType>::PairLJETENBatchKokkos(LAMMPS *lmp) :
+  PairLJETENKokkos<DeviceType>(lmp)
+{
+  // the virial is accumulated explicitly, ghost atoms never carry force
+
+  this->no_virial_fdotr_compute = 1;
+
+  nreplica = 0;
+  nper = 0;
+  nlocal_map = -1;
+}
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PairLJETENBatchKokkos<DeviceType>::compute(int eflag_in, int vflag_in)
+{
+  this->eflag = eflag_in;
+  this->vflag = vflag_in;
+
+  this->ev_init(this->eflag,this->vflag,0);
+
+  // reallocate per-atom arrays if necessary
+
+  if (this->eflag_atom) {
+    this->memoryKK->destroy_kokkos(this->k_eatom,this->eatom);
+    this->memoryKK->create_kokkos(this->k_eatom,this->eatom,this->maxeatom,"pair:eatom");
+    this->d_eatom = this->k_eatom.template view<DeviceType>();
+  }
+  if (this->vflag_atom) {
+    this->memoryKK->destroy_kokkos(this->k_vatom,this->vatom);
+    this->memoryKK->create_kokkos(this->k_vatom,this->vatom,this->maxvatom,"pair:vatom");
+    this->d_vatom = this->k_vatom.template view<DeviceType>();
+  }
+
+  this->atomKK->sync(this->execution_space,this->datamask_read);
+  this->k_params.template sync<DeviceType>();
+  if (this->eflag || this->vflag) this->atomKK->modified(this->execution_space,this->datamask_modify);
+  else this->atomKK->modified(this->execution_space,F_MASK);
+
+  this->x = this->atomKK->k_x.template view<DeviceType>();
+  this->f = this->atomKK->k_f.template view<DeviceType>();
+  this->type = this->atomKK->k_type.template view<DeviceType>();
+  this->nlocal = this->atom->nlocal;
+
+  // atoms are only reordered when neighbor lists are rebuilt
+
+  if (this->neighbor->ago == 0 || this->nlocal != nlocal_map) map_replicas();
+
+  // the box may change every step, e.g. with fix npt or fix deform
+
+  update_box();
+
+  // one team per replica, its coordinates and types in team scratch
+
+  this->copymode = 1;
+
+  const int scratch = t_scratch_x::shmem_size(nper) + t_scratch_int::shmem_size(nper);
+  EV_FLOAT ev;
+
+  if (this->evflag) {
+    Kokkos::TeamPolicy<DeviceType,TagPairLJETENBatchCompute<1>> policy(nreplica,Kokkos::AUTO);
+    Kokkos::parallel_reduce(policy.set_scratch_size(0,Kokkos::PerTeam(scratch)),*this,ev);
+  } else {
+    Kokkos::TeamPolicy<DeviceType,TagPairLJETENBatchCompute<0>> policy(nreplica,Kokkos::AUTO);
+    Kokkos::parallel_for(policy.set_scratch_size(0,Kokkos::PerTeam(scratch)),*this);
+  }
+
+  if (this->eflag_global) this->eng_vdwl += ev.evdwl;
+  if (this->vflag_global) {
+    this->virial[0] += ev.v[0];
+    this->virial[1] += ev.v[1];
+    this->virial[2] += ev.v[2];
+    this->virial[3] += ev.v[3];
+    this->virial[4] += ev.v[4];
+    this->virial[5] += ev.v[5];
+  }
+
+  if (this->eflag_atom) {
+    this->k_eatom.template modify<DeviceType>();
+    this->k_eatom.template sync<LMPHostType>();
+  }
+
+  if (this->vflag_atom) {
+    this->k_vatom.template modify<DeviceType>();
+    this->k_vatom.template sync<LMPHostType>();
+  }
+
+  this->copymode = 0;
+}
+
+/* ----------------------------------------------------------------------
+   evaluate all bead pairs of one replica, one team per replica.
+   every pair is visited from both sides and only the force on the
+   owning bead is updated, so no atomics are needed; energy and virial
+   are tallied with a factor of 0.5 accordingly.
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+template<int EVFLAG>
+KOKKOS_INLINE_FUNCTION
+void PairLJETENBatchKokkos<DeviceType>::operator()(TagPairLJETENBatchCompute<EVFLAG>,
+                                                   const member_type &team, EV_FLOAT &ev) const
+{
+  const int offset = team.league_rank()*nper;
+
+  t_scratch_x s_x(team.team_scratch(0),nper);
+  t_scratch_int s_type(team.team_scratch(0),nper);
+
+  Kokkos::parallel_for(Kokkos::TeamThreadRange(team,nper), [&] (const int &k) {
+    const int i = d_index(offset+k);
+    s_x(k,0) = this->x(i,0);
+    s_x(k,1) = this->x(i,1);
+    s_x(k,2) = this->x(i,2);
+    s_type(k) = this->type(i);
+  });
+  team.team_barrier();
+
+  EV_FLOAT ev_team;
+
+  Kokkos::parallel_reduce(Kokkos::TeamThreadRange(team,nper), [&] (const int &k, EV_FLOAT &ev_k) {
+    const X_FLOAT xtmp = s_x(k,0);
+    const X_FLOAT ytmp = s_x(k,1);
+    const X_FLOAT ztmp = s_x(k,2);
+    const int itype = s_type(k);
+
+    F_FLOAT fxtmp = 0.0;
+    F_FLOAT fytmp = 0.0;
+    F_FLOAT fztmp = 0.0;
+    E_FLOAT eatom_k = 0.0;
+    F_FLOAT vatom_k[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+    for (int l = 0; l < nper; l++) {
+      const F_FLOAT factor_lj = d_special(k,l);
+      if (factor_lj == 0.0) continue;
+
+      X_FLOAT delx = xtmp - s_x(l,0);
+      X_FLOAT dely = ytmp - s_x(l,1);
+      X_FLOAT delz = ztmp - s_x(l,2);
+      minimum_image(delx,dely,delz);
+      const F_FLOAT rsq = delx*delx + dely*dely + delz*delz;
+
+      const auto &p = this->d_params(itype,s_type(l));
+      if (rsq < p.cutsq) {
+        const F_FLOAT r2inv = 1.0/rsq;
+        const F_FLOAT r4inv = r2inv*r2inv;
+        const F_FLOAT r6inv = r4inv*r2inv;
+        const F_FLOAT forcelj = r6inv*(p.lj1*r6inv - p.lj2*r4inv + p.lj3);
+        const F_FLOAT fpair = factor_lj*forcelj*r2inv;
+
+        fxtmp += delx*fpair;
+        fytmp += dely*fpair;
+        fztmp += delz*fpair;
+
+        if (EVFLAG) {
+          if (this->eflag_either) {
+            const E_FLOAT evdwl = 0.5*factor_lj *
+              (r6inv*(p.lj4*r6inv - p.lj5*r4inv + p.lj6) - p.offset);
+            ev_k.evdwl += evdwl;
+            eatom_k += evdwl;
+          }
+          if (this->vflag_either) {
+            const F_FLOAT v[6] = {0.5*delx*delx*fpair, 0.5*dely*dely*fpair,
+                                  0.5*delz*delz*fpair, 0.5*delx*dely*fpair,
+                                  0.5*delx*delz*fpair, 0.5*dely*delz*fpair};
+            for (int n = 0; n < 6; n++) {
+              ev_k.v[n] += v[n];
+              vatom_k[n] += v[n];
+            }
+          }
+        }
+      }
+    }
+
+    const int i = d_index(offset+k);
+    this->f(i,0) += fxtmp;
+    this->f(i,1) += fytmp;
+    this->f(i,2) += fztmp;
+
+    if (EVFLAG) {
+      if (this->eflag_atom) this->d_eatom(i) += eatom_k;
+      if (this->vflag_atom)
+        for (int n = 0; n < 6; n++) this->d_vatom(i,n) += vatom_k[n];
+    }
+  }, ev_team);
+
+  Kokkos::single(Kokkos::PerTeam(team), [&] () {
+    ev += ev_team;
+  });
+}
+
+/* ---------------------------------------------------------------------- */
+
+template<class DeviceType>
+template<int EVFLAG>
+KOKKOS_INLINE_FUNCTION
+void PairLJETENBatchKokkos<DeviceType>::operator()(TagPairLJETENBatchCompute<EVFLAG>,
+                                                   const member_type &team) const
+{
+  EV_FLOAT ev;
+  this->template operator()<EVFLAG>(TagPairLJETENBatchCompute<EVFLAG>(), team, ev);
+}
+
+/* ----------------------------------------------------------------------
+   global settings: cutoff and number of replicas
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PairLJETENBatchKokkos<DeviceType>::settings(int narg, char **arg)
+{
+  if (narg != 2) this->error->all(FLERR,"Illegal pair_style command");
+
+  nreplica = utils::inumeric(FLERR,arg[1],false,this->lmp);
+  if (nreplica <= 0) this->error->all(FLERR,"Illegal pair_style command");
+
+  PairLJETENKokkos<DeviceType>::settings(1,arg);
+}
+
+/* ----------------------------------------------------------------------
+   init specific to this pair style
+   no neighbor list is requested, each team loops over all bead pairs
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PairLJETENBatchKokkos<DeviceType>::init_style()
+{
+  if (this->comm->nprocs != 1)
+    this->error->all(FLERR,"Pair style lj/eten/batch/kk requires a single MPI rank");
+  if (this->atom->map_style == Atom::MAP_NONE)
+    this->error->all(FLERR,"Pair style lj/eten/batch/kk requires an atom map");
+  if (this->domain->triclinic)
+    this->error->all(FLERR,"Pair style lj/eten/batch/kk requires an orthogonal box");
+  if (this->table_bits)
+    this->error->all(FLERR,"Pair style lj/eten/batch/kk does not support pair_modify table/lj");
+  if (this->atom->natoms % nreplica)
+    this->error->all(FLERR,"Number of atoms is not a multiple of the lj/eten/batch/kk replica count");
+  nper = this->atom->natoms / nreplica;
+
+  // error if rRESPA with inner levels
+
+  if (this->update->whichflag == 1 && utils::strmatch(this->update->integrate_style,"^respa")) {
+    int respa = 0;
+    if (((Respa *) this->update->integrate)->level_inner >= 0) respa = 1;
+    if (((Respa *) this->update->integrate)->level_middle >= 0) respa = 2;
+    if (respa)
+      this->error->all(FLERR,"Cannot use Kokkos pair style with rRESPA inner/middle");
+  }
+
+  setup_special();
+  nlocal_map = -1;
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 writes to restart file
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PairLJETENBatchKokkos<DeviceType>::write_restart_settings(FILE *fp)
+{
+  PairLJETENKokkos<DeviceType>::write_restart_settings(fp);
+  fwrite(&nreplica,sizeof(int),1,fp);
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 reads from restart file, bcasts
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PairLJETENBatchKokkos<DeviceType>::read_restart_settings(FILE *fp)
+{
+  PairLJETENKokkos<DeviceType>::read_restart_settings(fp);
+  if (this->comm->me == 0)
+    utils::sfread(FLERR,&nreplica,sizeof(int),1,fp,nullptr,this->error);
+  MPI_Bcast(&nreplica,1,MPI_INT,0,this->world);
+}
+
+/* ----------------------------------------------------------------------
+   locate the beads of every replica, replica r owns tags r*nper+1 .. (r+1)*nper
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PairLJETENBatchKokkos<DeviceType>::map_replicas()
+{
+  Atom *atom = this->atom;
+  const int nlocal = atom->nlocal;
+  const int natoms = nreplica*nper;
+
+  if ((int) k_index.extent(0) < natoms)
+    k_index = DAT::tdual_int_1d("pair:index",natoms);
+
+  for (int n = 0; n < natoms; n++) {
+    const int i = atom->map(n+1);
+    if (i < 0 || i >= nlocal)
+      this->error->one(FLERR,"Pair style lj/eten/batch/kk cannot find atom {}",n+1);
+    k_index.h_view(n) = i;
+  }
+  k_index.template modify<LMPHostType>();
+  k_index.template sync<DeviceType>();
+  d_index = k_index.template view<DeviceType>();
+  nlocal_map = nlocal;
+}
+
+/* ----------------------------------------------------------------------
+   box lengths for the minimum image of the current step
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PairLJETENBatchKokkos<DeviceType>::update_box()
+{
+  Domain *domain = this->domain;
+
+  // minimum image is only unique while the cutoff fits into half the box
+
+  prd[0] = domain->xprd;
+  prd[1] = domain->yprd;
+  prd[2] = domain->zprd;
+  periodic[0] = domain->xperiodic;
+  periodic[1] = domain->yperiodic;
+  periodic[2] = domain->zperiodic;
+  for (int d = 0; d < 3; d++) {
+    prd_half[d] = 0.5*prd[d];
+    if (periodic[d] && this->cutforce > prd_half[d])
+      this->error->all(FLERR,"Pair style lj/eten/batch/kk cutoff exceeds half the periodic box");
+  }
+}
+
+/* ----------------------------------------------------------------------
+   bead pair special factors from the bond topology of replica 0
+   all other replicas are assumed to be copies of it
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+void PairLJETENBatchKokkos<DeviceType>::setup_special()
+{
+  Atom *atom = this->atom;
+  double *special_lj = this->force->special_lj;
+
+  k_special = DAT::tdual_ffloat_2d("pair:special",nper,nper);
+  for (int k = 0; k < nper; k++)
+    for (int l = 0; l < nper; l++)
+      k_special.h_view(k,l) = (k == l) ? 0.0 : 1.0;
+
+  if (atom->molecular != Atom::ATOMIC) {
+    tagint *tag = atom->tag;
+    int **nspecial = atom->nspecial;
+    tagint **special = atom->special;
+
+    for (int i = 0; i < atom->nlocal; i++) {
+      if (tag[i] > nper) continue;
+      const int k = tag[i] - 1;
+      for (int s = 0; s < nspecial[i][2]; s++) {
+        const tagint t = special[i][s];
+        if (t > nper)
+          this->error->all(FLERR,"Pair style lj/eten/batch/kk does not allow bonds between replicas");
+        const int which = (s < nspecial[i][0]) ? 1 : ((s < nspecial[i][1]) ? 2 : 3);
+        k_special.h_view(k,t-1) = special_lj[which];
+      }
+    }
+  }
+
+  k_special.template modify<LMPHostType>();
+  k_special.template sync<DeviceType>();
+  d_special = k_special.template view<DeviceType>();
+}
+
+/* ----------------------------------------------------------------------
+   minimum image convention for orthogonal boxes, cf. Domain::minimum_image()
+------------------------------------------------------------------------- */
+
+template<class DeviceType>
+KOKKOS_INLINE_FUNCTION
+void PairLJETENBatchKokkos<DeviceType>::minimum_image(X_FLOAT &dx, X_FLOAT &dy, X_FLOAT &dz) const
+{
+  if (periodic[0]) {
+    if (dx > prd_half[0]) dx -= prd[0];
+    else if (dx < -prd_half[0]) dx += prd[0];
+  }
+  if (periodic[1]) {
+    if (dy > prd_half[1]) dy -= prd[1];
+    else if (dy < -prd_half[1]) dy += prd[1];
+  }
+  if (periodic[2]) {
+    if (dz > prd_half[2]) dz -= prd[2];
+    else if (dz < -prd_half[2]) dz += prd[2];
+  }
+}
+
+namespace LAMMPS_NS {
+template class PairLJETENBatchKokkos<LMPDeviceType>;
+#ifdef LMP_KOKKOS_GPU
+template class PairLJETENBatchKokkos<LMPHostType>;
+#endif
+}
+
@@ -0,0 +1,99 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   Batched KOKKOS version of pair style lj/eten for many independent,
+   equally sized replicas of a small chain held in one simulation box.
+   Each replica is evaluated by one team with its coordinates staged in
+   team scratch memory; all teams share one parameter table.
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(lj/eten/batch/kk,PairLJETENBatchKokkos<LMPDeviceType>);
+PairStyle(lj/eten/batch/kk/device,PairLJETENBatchKokkos<LMPDeviceType>);
+PairStyle(lj/eten/batch/kk/host,PairLJETENBatchKokkos<LMPHostType>);
+// clang-format on
+#else
+
+// clang-format off
+#ifndef LMP_PAIR_LJ_ETEN_BATCH_KOKKOS_H
+#define LMP_PAIR_LJ_ETEN_BATCH_KOKKOS_H
+
+#include "pair_lj_eten_kokkos.h"
+
+namespace LAMMPS_NS {
+
+template<int EVFLAG>
+struct TagPairLJETENBatchCompute{};
+
+template<class DeviceType>
+class PairLJETENBatchKokkos : public PairLJETENKokkos<DeviceType> {
+ public:
+  typedef DeviceType device_type;
+  typedef ArrayTypes<DeviceType> AT;
+  typedef Kokkos::TeamPolicy<DeviceType> team_policy;
+  typedef typename team_policy::member_type member_type;
+  typedef typename DeviceType::scratch_memory_space t_scratch_space;
+  typedef Kokkos::View<F_FLOAT*[3],Kokkos::LayoutRight,t_scratch_space,
+                       Kokkos::MemoryTraits<Kokkos::Unmanaged>> t_scratch_x;
+  typedef Kokkos::View<int*,t_scratch_space,
+                       Kokkos::MemoryTraits<Kokkos::Unmanaged>> t_scratch_int;
+
+  PairLJETENBatchKokkos(class LAMMPS *);
+
+  void compute(int, int) override;
+  void settings(int, char **) override;
+  void init_style() override;
+  void write_restart_settings(FILE *) override;
+  void read_restart_settings(FILE *) override;
+
+  template<int EVFLAG>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPairLJETENBatchCompute<EVFLAG>, const member_type &, EV_FLOAT &) const;
+
+  template<int EVFLAG>
+  KOKKOS_INLINE_FUNCTION
+  void operator()(TagPairLJETENBatchCompute<EVFLAG>, const member_type &) const;
+
+ protected:
+  int nreplica;                       // number of independent replicas
+  int nper;                           // atoms per replica
+  int nlocal_map;                     // nlocal when d_index was last built
+
+  // local index of bead k of replica r is d_index(r*nper + k)
+
+  DAT::tdual_int_1d k_index;
+  typename AT::t_int_1d_randomread d_index;
+
+  // special factor for bead pair (k,l), taken from replica 0 and shared
+  // by all replicas; 1.0 for non-bonded pairs
+
+  DAT::tdual_ffloat_2d k_special;
+  typename AT::t_ffloat_2d d_special;
+
+  X_FLOAT prd[3], prd_half[3];
+  int periodic[3];
+
+  void map_replicas();
+  void update_box();
+  void setup_special();
+
+  KOKKOS_INLINE_FUNCTION
+  void minimum_image(X_FLOAT &, X_FLOAT &, X_FLOAT &) const;
+};
+
+}
+
+#endif
+#endif
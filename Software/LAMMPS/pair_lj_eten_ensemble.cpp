@@ -0,0 +1,386 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   Ensemble version of pair style lj/eten for many independent replicas
+   of one chain with identical topology and types. Each bead pair is
+   evaluated for all replicas in one vectorized sweep with its
+   coefficients loaded once.
+------------------------------------------------------------------------- */
+
+#include "pair_lj_eten_ensemble.h"
+
+#include "atom.h"
+#include "comm.h"
+#include "domain.h"
+#include "error.h"
+#include "force.h"
+#include "memory.h"
+#include "neighbor.h"
+
+#include <cmath>
+#include <cstring>
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+PairLJETENEnsemble::PairLJETENEnsemble(LAMMPS *lmp) : PairLJETEN(lmp)
+{
+  respa_enable = 0;
+  scale_in_kernel = 0;
+
+  // the virial is accumulated explicitly, ghost atoms never carry force
+
+  no_virial_fdotr_compute = 1;
+
+  nreplica = nper = npair = 0;
+  nlocal_map = -1;
+  pairs = nullptr;
+  index = nullptr;
+  xr = fr = er = vr = nullptr;
+}
+
+/* ---------------------------------------------------------------------- */
+
+PairLJETENEnsemble::~PairLJETENEnsemble()
+{
+  memory->sfree(pairs);
+  memory->destroy(index);
+  memory->destroy(xr);
+  memory->destroy(fr);
+  memory->destroy(er);
+  memory->destroy(vr);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairLJETENEnsemble::compute(int eflag, int vflag)
+{
+  ev_init(eflag, vflag);
+
+  // atoms are only reordered when neighbor lists are rebuilt
+
+  if (neighbor->ago == 0 || atom->nlocal != nlocal_map) map_replicas();
+
+  // minimum image is only unique while the cutoff fits into half the box
+
+  const int periodic[3] = {domain->xperiodic, domain->yperiodic, domain->zperiodic};
+  const double length[3] = {domain->xprd, domain->yprd, domain->zprd};
+  for (int d = 0; d < 3; d++) {
+    prd[d] = periodic[d] ? length[d] : 0.0;
+    prdinv[d] = periodic[d] ? 1.0 / length[d] : 0.0;
+    if (periodic[d] && cutforce > 0.5 * length[d])
+      error->all(FLERR, "Pair style lj/eten/ensemble cutoff exceeds half the periodic box");
+  }
+
+  double **x = atom->x;
+  double **f = atom->f;
+  const int peratom = eflag_atom || vflag_atom;
+  const int nrep = nreplica;
+
+  // gather replica coordinates into structure of arrays layout
+
+  for (int r = 0; r < nrep; r++) {
+    const int *idx = index + r * nper;
+    for (int k = 0; k < nper; k++) {
+      const int i = idx[k];
+      xr[(3 * k) * nrep + r] = x[i][0];
+      xr[(3 * k + 1) * nrep + r] = x[i][1];
+      xr[(3 * k + 2) * nrep + r] = x[i][2];
+    }
+  }
+  memset(fr, 0, sizeof(double) * 3 * nper * nrep);
+  if (peratom) {
+    memset(er, 0, sizeof(double) * nper * nrep);
+    memset(vr, 0, sizeof(double) * 6 * nper * nrep);
+  }
+
+  if (evflag) {
+    if (peratom) eval<1, 1>();
+    else eval<1, 0>();
+  } else eval<0, 0>();
+
+  // scatter forces and per-atom tallies back to the owning atoms
+
+  for (int r = 0; r < nrep; r++) {
+    const int *idx = index + r * nper;
+    for (int k = 0; k < nper; k++) {
+      const int i = idx[k];
+      f[i][0] += fr[(3 * k) * nrep + r];
+      f[i][1] += fr[(3 * k + 1) * nrep + r];
+      f[i][2] += fr[(3 * k + 2) * nrep + r];
+      if (eflag_atom) eatom[i] += er[k * nrep + r];
+      if (vflag_atom)
+        for (int n = 0; n < 6; n++) vatom[i][n] += vr[(6 * k + n) * nrep + r];
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   evaluate every bead pair for all replicas, the inner loop runs over
+   replicas with unit stride and uniform coefficients
+------------------------------------------------------------------------- */
+
+template <int EVFLAG, int PERATOM> void PairLJETENEnsemble::eval()
+{
+  const int nrep = nreplica;
+  const double xprd = prd[0], yprd = prd[1], zprd = prd[2];
+  const double xprdinv = prdinv[0], yprdinv = prdinv[1], zprdinv = prdinv[2];
+  const int eflag = eflag_either;
+
+  double evdwl_sum = 0.0;
+  double v0 = 0.0, v1 = 0.0, v2 = 0.0, v3 = 0.0, v4 = 0.0, v5 = 0.0;
+
+  for (int n = 0; n < npair; n++) {
+    const BeadPair &bp = pairs[n];
+    const Param &p = params[bp.itype][bp.jtype];
+    const double cutsq = p.cutsq;
+    const double lj1 = p.lj1, lj2 = p.lj2, lj3 = p.lj3;
+    const double lj4 = p.lj4, lj5 = p.lj5, lj6 = p.lj6, offset = p.offset;
+    const double factor_lj = bp.factor_lj;
+
+    const double *_noalias const xk = xr + 3 * bp.k * nrep;
+    const double *_noalias const xl = xr + 3 * bp.l * nrep;
+    double *_noalias const fk = fr + 3 * bp.k * nrep;
+    double *_noalias const fl = fr + 3 * bp.l * nrep;
+    double *_noalias const ek = er + bp.k * nrep;
+    double *_noalias const el = er + bp.l * nrep;
+    double *_noalias const vk = vr + 6 * bp.k * nrep;
+    double *_noalias const vl = vr + 6 * bp.l * nrep;
+
+#if defined(_OPENMP)
+#pragma omp simd reduction(+ : evdwl_sum, v0, v1, v2, v3, v4, v5)
+#endif
+    for (int r = 0; r < nrep; r++) {
+      double delx = xk[r] - xl[r];
+      double dely = xk[nrep + r] - xl[nrep + r];
+      double delz = xk[2 * nrep + r] - xl[2 * nrep + r];
+
+      // branch free minimum image, prd and prdinv are 0 for non-periodic dims
+
+      delx -= xprd * floor(delx * xprdinv + 0.5);
+      dely -= yprd * floor(dely * yprdinv + 0.5);
+      delz -= zprd * floor(delz * zprdinv + 0.5);
+
+      const double rsq = delx * delx + dely * dely + delz * delz;
+      const double r2inv = 1.0 / rsq;
+      const double r4inv = r2inv * r2inv;
+      const double r6inv = r4inv * r2inv;
+      const double forcelj = r6inv * (lj1 * r6inv - lj2 * r4inv + lj3);
+      const double fpair = (rsq < cutsq) ? factor_lj * forcelj * r2inv : 0.0;
+
+      fk[r] += delx * fpair;
+      fk[nrep + r] += dely * fpair;
+      fk[2 * nrep + r] += delz * fpair;
+      fl[r] -= delx * fpair;
+      fl[nrep + r] -= dely * fpair;
+      fl[2 * nrep + r] -= delz * fpair;
+
+      if (EVFLAG) {
+        double evdwl = 0.0;
+        if (eflag && (rsq < cutsq))
+          evdwl = factor_lj * (r6inv * (lj4 * r6inv - lj5 * r4inv + lj6) - offset);
+        evdwl_sum += evdwl;
+
+        const double vxx = delx * delx * fpair;
+        const double vyy = dely * dely * fpair;
+        const double vzz = delz * delz * fpair;
+        const double vxy = delx * dely * fpair;
+        const double vxz = delx * delz * fpair;
+        const double vyz = dely * delz * fpair;
+        v0 += vxx;
+        v1 += vyy;
+        v2 += vzz;
+        v3 += vxy;
+        v4 += vxz;
+        v5 += vyz;
+
+        if (PERATOM) {
+          ek[r] += 0.5 * evdwl;
+          el[r] += 0.5 * evdwl;
+          vk[r] += 0.5 * vxx;
+          vk[nrep + r] += 0.5 * vyy;
+          vk[2 * nrep + r] += 0.5 * vzz;
+          vk[3 * nrep + r] += 0.5 * vxy;
+          vk[4 * nrep + r] += 0.5 * vxz;
+          vk[5 * nrep + r] += 0.5 * vyz;
+          vl[r] += 0.5 * vxx;
+          vl[nrep + r] += 0.5 * vyy;
+          vl[2 * nrep + r] += 0.5 * vzz;
+          vl[3 * nrep + r] += 0.5 * vxy;
+          vl[4 * nrep + r] += 0.5 * vxz;
+          vl[5 * nrep + r] += 0.5 * vyz;
+        }
+      }
+    }
+  }
+
+  if (EVFLAG) {
+    if (eflag_global) eng_vdwl += evdwl_sum;
+    if (vflag_global) {
+      virial[0] += v0;
+      virial[1] += v1;
+      virial[2] += v2;
+      virial[3] += v3;
+      virial[4] += v4;
+      virial[5] += v5;
+    }
+  }
+}
+
+/* ----------------------------------------------------------------------
+   global settings: cutoff and number of replicas
+------------------------------------------------------------------------- */
+
+void PairLJETENEnsemble::settings(int narg, char **arg)
+{
+  if (narg != 2) error->all(FLERR, "Illegal pair_style command");
+
+  nreplica = utils::inumeric(FLERR, arg[1], false, lmp);
+  if (nreplica <= 0) error->all(FLERR, "Illegal pair_style command");
+
+  PairLJETEN::settings(1, arg);
+}
+
+/* ----------------------------------------------------------------------
+   init specific to this pair style
+   no neighbor list is requested; the interacting bead pairs and their
+   special factors are taken once from the topology of replica 0,
+   replica r owns atom IDs r*nper+1 .. (r+1)*nper
+------------------------------------------------------------------------- */
+
+void PairLJETENEnsemble::init_style()
+{
+  if (comm->nprocs != 1) error->all(FLERR, "Pair style lj/eten/ensemble requires a single MPI rank");
+  if (table_bits) error->all(FLERR, "Pair style lj/eten/ensemble does not support pair_modify table/lj");
+  if (atom->map_style == Atom::MAP_NONE)
+    error->all(FLERR, "Pair style lj/eten/ensemble requires an atom map");
+  if (domain->triclinic)
+    error->all(FLERR, "Pair style lj/eten/ensemble requires an orthogonal box");
+  if (atom->natoms % nreplica)
+    error->all(FLERR, "Number of atoms is not a multiple of the lj/eten/ensemble replica count");
+  nper = atom->natoms / nreplica;
+
+  // dense special factor table of the reference replica
+
+  double *factor;
+  memory->create(factor, nper * nper, "pair:factor");
+  for (int k = 0; k < nper * nper; k++) factor[k] = 1.0;
+
+  if (atom->molecular != Atom::ATOMIC) {
+    tagint *tag = atom->tag;
+    int **nspecial = atom->nspecial;
+    tagint **special = atom->special;
+    double *special_lj = force->special_lj;
+
+    for (int i = 0; i < atom->nlocal; i++) {
+      if (tag[i] > nper) continue;
+      const int k = tag[i] - 1;
+      for (int s = 0; s < nspecial[i][2]; s++) {
+        const tagint t = special[i][s];
+        if (t > nper)
+          error->all(FLERR, "Pair style lj/eten/ensemble does not allow bonds between replicas");
+        const int which = (s < nspecial[i][0]) ? 1 : ((s < nspecial[i][1]) ? 2 : 3);
+        factor[k * nper + t - 1] = special_lj[which];
+      }
+    }
+  }
+
+  // keep only bead pairs k < l that interact at all
+
+  memory->sfree(pairs);
+  pairs = (BeadPair *) memory->smalloc(sizeof(BeadPair) * nper * (nper - 1) / 2 + 1, "pair:pairs");
+  npair = 0;
+  for (int k = 0; k < nper; k++)
+    for (int l = k + 1; l < nper; l++) {
+      if (factor[k * nper + l] == 0.0) continue;
+      pairs[npair].k = k;
+      pairs[npair].l = l;
+      pairs[npair].itype = pairs[npair].jtype = 0;
+      pairs[npair].factor_lj = factor[k * nper + l];
+      npair++;
+    }
+  memory->destroy(factor);
+
+  memory->destroy(index);
+  memory->destroy(xr);
+  memory->destroy(fr);
+  memory->destroy(er);
+  memory->destroy(vr);
+  memory->create(index, nper * nreplica, "pair:index");
+  memory->create(xr, 3 * nper * nreplica, "pair:xr");
+  memory->create(fr, 3 * nper * nreplica, "pair:fr");
+  memory->create(er, nper * nreplica, "pair:er");
+  memory->create(vr, 6 * nper * nreplica, "pair:vr");
+
+  nlocal_map = -1;
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 writes to restart file
+------------------------------------------------------------------------- */
+
+void PairLJETENEnsemble::write_restart_settings(FILE *fp)
+{
+  PairLJETEN::write_restart_settings(fp);
+  fwrite(&nreplica, sizeof(int), 1, fp);
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 reads from restart file, bcasts
+------------------------------------------------------------------------- */
+
+void PairLJETENEnsemble::read_restart_settings(FILE *fp)
+{
+  PairLJETEN::read_restart_settings(fp);
+  if (comm->me == 0) utils::sfread(FLERR, &nreplica, sizeof(int), 1, fp, nullptr, error);
+  MPI_Bcast(&nreplica, 1, MPI_INT, 0, world);
+}
+
+/* ----------------------------------------------------------------------
+   locate the beads of every replica and check that all replicas use
+   the atom types of the reference replica
+------------------------------------------------------------------------- */
+
+void PairLJETENEnsemble::map_replicas()
+{
+  const int nlocal = atom->nlocal;
+  const int *type = atom->type;
+  const int natoms = nreplica * nper;
+
+  for (int n = 0; n < natoms; n++) {
+    const int i = atom->map(n + 1);
+    if (i < 0 || i >= nlocal) error->one(FLERR, "Pair style lj/eten/ensemble cannot find atom {}", n + 1);
+    index[n] = i;
+    if (type[i] != type[index[n % nper]])
+      error->one(FLERR, "Pair style lj/eten/ensemble requires identical atom types in all replicas");
+  }
+
+  for (int n = 0; n < npair; n++) {
+    pairs[n].itype = type[index[pairs[n].k]];
+    pairs[n].jtype = type[index[pairs[n].l]];
+  }
+  nlocal_map = nlocal;
+}
+
+/* ---------------------------------------------------------------------- */
+
+double PairLJETENEnsemble::memory_usage()
+{
+  double bytes = Pair::memory_usage();
+  bytes += (double) npair * sizeof(BeadPair);
+  bytes += (double) nper * nreplica * sizeof(int);
+  bytes += (double) 13 * nper * nreplica * sizeof(double);
+  return bytes;
+}
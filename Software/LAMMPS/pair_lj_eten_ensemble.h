@@ -0,0 +1,68 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(lj/eten/ensemble,PairLJETENEnsemble);
+// clang-format on
+#else
+
+#ifndef LMP_PAIR_LJ_ETEN_ENSEMBLE_H
+#define LMP_PAIR_LJ_ETEN_ENSEMBLE_H
+
+#include "pair_lj_eten.h"
+
+namespace LAMMPS_NS {
+
+class PairLJETENEnsemble : public PairLJETEN {
+ public:
+  PairLJETENEnsemble(class LAMMPS *);
+  ~PairLJETENEnsemble() override;
+  void compute(int, int) override;
+  void settings(int, char **) override;
+  void init_style() override;
+  void write_restart_settings(FILE *) override;
+  void read_restart_settings(FILE *) override;
+  double memory_usage() override;
+  bool energy_sets_supported() const override { return false; }
+
+ protected:
+  // one interacting bead pair of the reference replica
+
+  struct BeadPair {
+    int k, l;
+    int itype, jtype;
+    double factor_lj;
+  };
+
+  int nreplica;       // number of independent replicas
+  int nper;           // atoms per replica
+  int npair;          // number of interacting bead pairs per replica
+  int nlocal_map;     // nlocal when index was last built
+  BeadPair *pairs;
+  int *index;         // local index of bead k of replica r is index[r*nper+k]
+
+  // replica coordinates, forces and per-atom tallies in structure of
+  // arrays layout, component d of bead k in replica r at [(3*k+d)*nreplica + r]
+
+  double *xr, *fr, *er, *vr;
+  double prd[3], prdinv[3];
+
+  void map_replicas();
+  template <int EVFLAG, int PERATOM> void eval();
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
@@ -0,0 +1,473 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   Vectorized version of pair style lj/eten for the INTEL package,
+   following pair style lj/cut/intel (host execution only)
+------------------------------------------------------------------------- */
+
+#include "pair_lj_eten_intel.h"
+
+#include "atom.h"
+#include "comm.h"
+#include "error.h"
+#include "force.h"
+#include "memory.h"
+#include "modify.h"
+#include "neigh_list.h"
+#include "neigh_request.h"
+#include "neighbor.h"
+#include "suffix.h"
+
+#include <cmath>
+#include <cstring>
+
+using namespace LAMMPS_NS;
+
+#define C_FORCE_T typename ForceConst<flt_t>::c_force_t
+#define C_ENERGY_T typename ForceConst<flt_t>::c_energy_t
+
+/* ---------------------------------------------------------------------- */
+
+PairLJETENIntel::PairLJETENIntel(LAMMPS *lmp) : PairLJETEN(lmp)
+{
+  suffix_flag |= Suffix::INTEL;
+  respa_enable = 0;
+  scale_in_kernel = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairLJETENIntel::compute(int eflag, int vflag)
+{
+  if (fix->precision()==FixIntel::PREC_MODE_MIXED)
+    compute<float,double>(eflag, vflag, fix->get_mixed_buffers(),
+                          force_const_single);
+  else if (fix->precision()==FixIntel::PREC_MODE_DOUBLE)
+    compute<double,double>(eflag, vflag, fix->get_double_buffers(),
+                           force_const_double);
+  else
+    compute<float,float>(eflag, vflag, fix->get_single_buffers(),
+                         force_const_single);
+
+  fix->balance_stamp();
+  vflag_fdotr = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+void PairLJETENIntel::compute(int eflag, int vflag,
+                              IntelBuffers<flt_t,acc_t> *buffers,
+                              const ForceConst<flt_t> &fc)
+{
+  ev_init(eflag, vflag);
+  if (vflag_atom)
+    error->all(FLERR,"INTEL package does not support per-atom stress");
+  if (vflag && !vflag_fdotr && force->newton_pair)
+    error->all(FLERR,"INTEL package does not support pair_modify nofdotr "
+               "with newton_pair yes");
+
+  const int inum = list->inum;
+  const int nthreads = comm->nthreads;
+  const int host_start = fix->host_start_pair();
+  const int ago = neighbor->ago;
+
+  if (ago != 0 && fix->separate_buffers() == 0) {
+    fix->start_watch(TIME_PACK);
+
+    int packthreads;
+    if (nthreads > INTEL_HTHREADS) packthreads = nthreads;
+    else packthreads = 1;
+    #if defined(_OPENMP)
+    #pragma omp parallel if (packthreads > 1)
+    #endif
+    {
+      int ifrom, ito, tid;
+      IP_PRE_omp_range_id_align(ifrom, ito, tid, atom->nlocal + atom->nghost,
+                                packthreads, sizeof(ATOM_T));
+      buffers->thr_pack(ifrom,ito,ago);
+    }
+    fix->stop_watch(TIME_PACK);
+  }
+
+  int ovflag = 0;
+  if (vflag_fdotr) ovflag = 2;
+  else if (vflag) ovflag = 1;
+  if (_onetype) {
+    if (eflag) {
+      if (force->newton_pair) eval<1,1,1>(0, ovflag, buffers, fc, host_start, inum);
+      else eval<1,1,0>(0, ovflag, buffers, fc, host_start, inum);
+    } else {
+      if (force->newton_pair) eval<1,0,1>(0, ovflag, buffers, fc, host_start, inum);
+      else eval<1,0,0>(0, ovflag, buffers, fc, host_start, inum);
+    }
+  } else {
+    if (eflag) {
+      if (force->newton_pair) eval<0,1,1>(0, ovflag, buffers, fc, host_start, inum);
+      else eval<0,1,0>(0, ovflag, buffers, fc, host_start, inum);
+    } else {
+      if (force->newton_pair) eval<0,0,1>(0, ovflag, buffers, fc, host_start, inum);
+      else eval<0,0,0>(0, ovflag, buffers, fc, host_start, inum);
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <int ONETYPE, int EFLAG, int NEWTON_PAIR, class flt_t, class acc_t>
+void PairLJETENIntel::eval(const int offload, const int vflag,
+                           IntelBuffers<flt_t,acc_t> *buffers,
+                           const ForceConst<flt_t> &fc,
+                           const int astart, const int aend)
+{
+  const int inum = aend - astart;
+  if (inum == 0) return;
+  int nlocal, nall, minlocal;
+  fix->get_buffern(offload, nlocal, nall, minlocal);
+
+  const int ago = neighbor->ago;
+  IP_PRE_pack_separate_buffers(fix, buffers, ago, offload, nlocal, nall);
+
+  ATOM_T * _noalias const x = buffers->get_x(offload);
+
+  const int * _noalias const ilist = list->ilist;
+  const int * _noalias const numneigh = list->numneigh;
+  const int ** _noalias const firstneigh = (const int **)list->firstneigh;
+
+  const flt_t * _noalias const special_lj = fc.special_lj;
+  const C_FORCE_T * _noalias const c_force = fc.c_force[0];
+  const C_ENERGY_T * _noalias const c_energy = fc.c_energy[0];
+
+  const int ntypes = atom->ntypes + 1;
+  const int eatom = this->eflag_atom;
+
+  // Determine how much data to transfer
+  int x_size, q_size, f_stride, ev_size, separate_flag;
+  IP_PRE_get_transfern(ago, NEWTON_PAIR, EFLAG, vflag,
+                       buffers, offload, fix, separate_flag,
+                       x_size, q_size, ev_size, f_stride);
+
+  int tc;
+  FORCE_T * _noalias f_start;
+  acc_t * _noalias ev_global;
+  IP_PRE_get_buffers(offload, buffers, fix, tc, f_start, ev_global);
+  const int nthreads = tc;
+  {
+    IP_PRE_repack_for_offload(NEWTON_PAIR, separate_flag, nlocal, nall,
+                              f_stride, x, 0);
+
+    acc_t oevdwl, ov0, ov1, ov2, ov3, ov4, ov5;
+    if (EFLAG) oevdwl = (acc_t)0;
+    if (vflag) ov0 = ov1 = ov2 = ov3 = ov4 = ov5 = (acc_t)0;
+
+    // loop over neighbors of my atoms
+    #if defined(_OPENMP)
+    #pragma omp parallel reduction(+:oevdwl,ov0,ov1,ov2,ov3,ov4,ov5)
+    #endif
+    {
+      int iifrom, iip, iito, tid;
+      IP_PRE_omp_stride_id(iifrom, iip, iito, tid, inum, nthreads);
+      iifrom += astart;
+      iito += astart;
+
+      FORCE_T * _noalias const f = f_start - minlocal + (tid * f_stride);
+      memset(f + minlocal, 0, f_stride * sizeof(FORCE_T));
+
+      // with a single type pair the coefficients stay in registers
+
+      flt_t cutsq, lj1, lj2, lj3, lj4, lj5, lj6, offset;
+      if (ONETYPE) {
+        cutsq = c_force[ntypes + 1].cutsq;
+        lj1 = c_force[ntypes + 1].lj1;
+        lj2 = c_force[ntypes + 1].lj2;
+        lj3 = c_force[ntypes + 1].lj3;
+        lj4 = c_energy[ntypes + 1].lj4;
+        lj5 = c_energy[ntypes + 1].lj5;
+        lj6 = c_energy[ntypes + 1].lj6;
+        offset = c_energy[ntypes + 1].offset;
+      }
+
+      for (int ii = iifrom; ii < iito; ii += iip) {
+        const int i = ilist[ii];
+        int itype, ptr_off;
+        const C_FORCE_T * _noalias c_forcei;
+        const C_ENERGY_T * _noalias c_energyi;
+        if (!ONETYPE) {
+          itype = x[i].w;
+          ptr_off = itype * ntypes;
+          c_forcei = c_force + ptr_off;
+          c_energyi = c_energy + ptr_off;
+        }
+
+        const int * _noalias const jlist = firstneigh[i];
+        int jnum = numneigh[i];
+        IP_PRE_neighbor_pad(jnum, offload);
+
+        acc_t fxtmp, fytmp, fztmp, fwtmp;
+        acc_t sevdwl, sv0, sv1, sv2, sv3, sv4, sv5;
+
+        const flt_t xtmp = x[i].x;
+        const flt_t ytmp = x[i].y;
+        const flt_t ztmp = x[i].z;
+        fxtmp = fytmp = fztmp = (acc_t)0;
+        if (EFLAG) fwtmp = sevdwl = (acc_t)0;
+        if (NEWTON_PAIR == 0)
+          if (vflag == VIRIAL_PAIR) sv0 = sv1 = sv2 = sv3 = sv4 = sv5 = (acc_t)0;
+
+        // the j loop is branch free apart from the cutoff mask:
+        // coordinates and types come from the packed x buffer,
+        // and the special bond factor is a 4 entry table lookup
+
+        #if defined(LMP_SIMD_COMPILER)
+        #pragma vector aligned
+        #pragma simd reduction(+:fxtmp, fytmp, fztmp, fwtmp, sevdwl, \
+                               sv0, sv1, sv2, sv3, sv4, sv5)
+        #endif
+        for (int jj = 0; jj < jnum; jj++) {
+          flt_t forcelj, evdwl;
+          forcelj = evdwl = (flt_t)0.0;
+
+          int j, jtype, sbindex;
+          if (!ONETYPE) {
+            sbindex = jlist[jj] >> SBBITS & 3;
+            j = jlist[jj] & NEIGHMASK;
+          } else
+            j = jlist[jj];
+
+          const flt_t delx = xtmp - x[j].x;
+          const flt_t dely = ytmp - x[j].y;
+          const flt_t delz = ztmp - x[j].z;
+          if (!ONETYPE) {
+            jtype = x[j].w;
+            cutsq = c_forcei[jtype].cutsq;
+          }
+          const flt_t rsq = delx * delx + dely * dely + delz * delz;
+
+          #if defined(LMP_SIMD_COMPILER)
+          if (rsq < cutsq) {
+          #endif
+            flt_t factor_lj;
+            if (!ONETYPE) factor_lj = special_lj[sbindex];
+            const flt_t r2inv = (flt_t)1.0 / rsq;
+            const flt_t r4inv = r2inv * r2inv;
+            const flt_t r6inv = r4inv * r2inv;
+            #if !defined(LMP_SIMD_COMPILER)
+            if (rsq > cutsq)
+              forcelj = (flt_t)0.0;
+            else
+            #endif
+            {
+              if (!ONETYPE) {
+                lj1 = c_forcei[jtype].lj1;
+                lj2 = c_forcei[jtype].lj2;
+                lj3 = c_forcei[jtype].lj3;
+              }
+              forcelj = r6inv * (lj1 * r6inv - lj2 * r4inv + lj3);
+            }
+            if (!ONETYPE) forcelj *= factor_lj;
+            const flt_t fpair = forcelj * r2inv;
+
+            const flt_t fpx = fpair * delx;
+            fxtmp += fpx;
+            if (NEWTON_PAIR) f[j].x -= fpx;
+            const flt_t fpy = fpair * dely;
+            fytmp += fpy;
+            if (NEWTON_PAIR) f[j].y -= fpy;
+            const flt_t fpz = fpair * delz;
+            fztmp += fpz;
+            if (NEWTON_PAIR) f[j].z -= fpz;
+
+            if (EFLAG) {
+              if (!ONETYPE) {
+                lj4 = c_energyi[jtype].lj4;
+                lj5 = c_energyi[jtype].lj5;
+                lj6 = c_energyi[jtype].lj6;
+                offset = c_energyi[jtype].offset;
+              }
+              evdwl = r6inv * (lj4 * r6inv - lj5 * r4inv + lj6);
+              #if defined(LMP_SIMD_COMPILER)
+              evdwl -= offset;
+              #else
+              if (rsq < cutsq) evdwl -= offset;
+              else evdwl = (flt_t)0.0;
+              #endif
+              if (!ONETYPE) evdwl *= factor_lj;
+              sevdwl += evdwl;
+              if (eatom) {
+                fwtmp += (flt_t)0.5 * evdwl;
+                if (NEWTON_PAIR)
+                  f[j].w += (flt_t)0.5 * evdwl;
+              }
+            }
+
+            if (NEWTON_PAIR == 0)
+              IP_PRE_ev_tally_nborv(vflag, delx, dely, delz, fpx, fpy, fpz);
+          #if defined(LMP_SIMD_COMPILER)
+          } // if rsq
+          #endif
+        } // for jj
+        if (NEWTON_PAIR) {
+          f[i].x += fxtmp;
+          f[i].y += fytmp;
+          f[i].z += fztmp;
+        } else {
+          f[i].x = fxtmp;
+          f[i].y = fytmp;
+          f[i].z = fztmp;
+        }
+
+        IP_PRE_ev_tally_atom(NEWTON_PAIR, EFLAG, vflag, f, fwtmp);
+      } // for ii
+
+      IP_PRE_fdotr_reduce_omp(NEWTON_PAIR, nall, minlocal, nthreads, f_start,
+                              f_stride, x, offload, vflag, ov0, ov1, ov2, ov3,
+                              ov4, ov5);
+    } // end omp
+
+    IP_PRE_fdotr_reduce(NEWTON_PAIR, nall, nthreads, f_stride, vflag,
+                        ov0, ov1, ov2, ov3, ov4, ov5);
+
+    if (EFLAG) {
+      if (NEWTON_PAIR == 0) oevdwl *= (acc_t)0.5;
+      ev_global[0] = oevdwl;
+      ev_global[1] = (acc_t)0.0;
+    }
+    if (vflag) {
+      if (NEWTON_PAIR == 0) {
+        ov0 *= (acc_t)0.5;
+        ov1 *= (acc_t)0.5;
+        ov2 *= (acc_t)0.5;
+        ov3 *= (acc_t)0.5;
+        ov4 *= (acc_t)0.5;
+        ov5 *= (acc_t)0.5;
+      }
+      ev_global[2] = ov0;
+      ev_global[3] = ov1;
+      ev_global[4] = ov2;
+      ev_global[5] = ov3;
+      ev_global[6] = ov4;
+      ev_global[7] = ov5;
+    }
+  }
+
+  fix->stop_watch(TIME_HOST_PAIR);
+
+  if (EFLAG || vflag)
+    fix->add_result_array(f_start, ev_global, offload, eatom, 0, vflag);
+  else
+    fix->add_result_array(f_start, nullptr, offload);
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairLJETENIntel::init_style()
+{
+  PairLJETEN::init_style();
+  auto request = neighbor->find_request(this);
+
+  // without newton the kernel only updates atom i and needs a full list
+
+  if (force->newton_pair == 0) request->enable_full();
+  request->intel = 1;
+
+  fix = static_cast<FixIntel *>(modify->get_fix_by_id("package_intel"));
+  if (!fix) error->all(FLERR, "The 'package intel' command is required for /intel styles");
+
+  fix->pair_init_check();
+  #ifdef _LMP_INTEL_OFFLOAD
+  if (fix->offload_balance() != 0.0)
+    error->all(FLERR, "Offload to a coprocessor is not supported by pair style lj/eten/intel");
+  #endif
+  _cop = fix->coprocessor_number();
+
+  if (fix->precision() == FixIntel::PREC_MODE_MIXED)
+    pack_force_const(force_const_single, fix->get_mixed_buffers());
+  else if (fix->precision() == FixIntel::PREC_MODE_DOUBLE)
+    pack_force_const(force_const_double, fix->get_double_buffers());
+  else
+    pack_force_const(force_const_single, fix->get_single_buffers());
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t, class acc_t>
+void PairLJETENIntel::pack_force_const(ForceConst<flt_t> &fc,
+                                       IntelBuffers<flt_t,acc_t> *buffers)
+{
+  _onetype = 0;
+  if (atom->ntypes == 1 && !atom->molecular) _onetype = 1;
+
+  int tp1 = atom->ntypes + 1;
+  fc.set_ntypes(tp1,memory,_cop);
+  buffers->set_ntypes(tp1);
+  flt_t **cutneighsq = buffers->get_cutneighsq();
+
+  // Repeat cutsq calculation because done after call to init_style
+  // the tolerance statistics only count the init_one() calls of Pair::init()
+  const int tol_pending_save = tol_pending;
+  tol_pending = 0;
+  double cut, cutneigh;
+  for (int i = 1; i <= atom->ntypes; i++) {
+    for (int j = i; j <= atom->ntypes; j++) {
+      if (setflag[i][j] != 0 || (setflag[i][i] != 0 && setflag[j][j] != 0)) {
+        cut = init_one(i,j);
+        cutneigh = cut + neighbor->skin;
+        cutsq[i][j] = cutsq[j][i] = cut*cut;
+        cutneighsq[i][j] = cutneighsq[j][i] = cutneigh * cutneigh;
+      }
+    }
+  }
+  tol_pending = tol_pending_save;
+
+  for (int i = 0; i < 4; i++) {
+    fc.special_lj[i] = force->special_lj[i];
+    fc.special_lj[0] = 1.0;
+  }
+
+  for (int i = 1; i < tp1; i++) {
+    for (int j = 1; j < tp1; j++) {
+      const Param &p = params[i][j];
+      fc.c_force[i][j].cutsq = p.cutsq;
+      fc.c_force[i][j].lj1 = p.lj1;
+      fc.c_force[i][j].lj2 = p.lj2;
+      fc.c_force[i][j].lj3 = p.lj3;
+      fc.c_energy[i][j].lj4 = p.lj4;
+      fc.c_energy[i][j].lj5 = p.lj5;
+      fc.c_energy[i][j].lj6 = p.lj6;
+      fc.c_energy[i][j].offset = p.offset;
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <class flt_t>
+void PairLJETENIntel::ForceConst<flt_t>::set_ntypes(const int ntypes,
+                                                    Memory *memory,
+                                                    const int cop) {
+  if (ntypes != _ntypes) {
+    if (_ntypes > 0) {
+      _memory->destroy(c_force);
+      _memory->destroy(c_energy);
+    }
+    if (ntypes > 0) {
+      _cop = cop;
+      memory->create(c_force,ntypes,ntypes,"fc.c_force");
+      memory->create(c_energy,ntypes,ntypes,"fc.c_energy");
+    }
+  }
+  _ntypes = ntypes;
+  _memory = memory;
+}
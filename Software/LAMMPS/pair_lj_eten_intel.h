@@ -0,0 +1,90 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   Vectorized version of pair style lj/eten for the INTEL package,
+   modeled after pair style lj/cut/intel
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(lj/eten/intel,PairLJETENIntel);
+// clang-format on
+#else
+
+#ifndef LMP_PAIR_LJ_ETEN_INTEL_H
+#define LMP_PAIR_LJ_ETEN_INTEL_H
+
+#include "fix_intel.h"
+#include "pair_lj_eten.h"
+
+namespace LAMMPS_NS {
+
+class PairLJETENIntel : public PairLJETEN {
+
+ public:
+  PairLJETENIntel(class LAMMPS *);
+
+  void compute(int, int) override;
+  void init_style() override;
+  bool energy_sets_supported() const override { return false; }
+
+ private:
+  FixIntel *fix;
+  int _cop, _onetype;
+
+  template <class flt_t> class ForceConst;
+  template <class flt_t, class acc_t>
+  void compute(int eflag, int vflag, IntelBuffers<flt_t, acc_t> *buffers,
+               const ForceConst<flt_t> &fc);
+  template <int ONETYPE, int EFLAG, int NEWTON_PAIR, class flt_t, class acc_t>
+  void eval(const int offload, const int vflag, IntelBuffers<flt_t, acc_t> *buffers,
+            const ForceConst<flt_t> &fc, const int astart, const int aend);
+
+  template <class flt_t, class acc_t>
+  void pack_force_const(ForceConst<flt_t> &fc, IntelBuffers<flt_t, acc_t> *buffers);
+
+  // ----------------------------------------------------------------------
+
+  template <class flt_t> class ForceConst {
+   public:
+    // force terms and energy terms are kept apart, so the force-only
+    // kernel gathers four contiguous values per neighbor
+
+    typedef struct {
+      flt_t cutsq, lj1, lj2, lj3;
+    } c_force_t;
+    typedef struct {
+      flt_t lj4, lj5, lj6, offset;
+    } c_energy_t;
+    _alignvar(flt_t special_lj[4], 64);
+    c_force_t **c_force;
+    c_energy_t **c_energy;
+
+    ForceConst() : c_force(nullptr), c_energy(nullptr), _ntypes(0) {}
+    ~ForceConst() { set_ntypes(0, nullptr, _cop); }
+
+    void set_ntypes(const int ntypes, Memory *memory, const int cop);
+
+   private:
+    int _ntypes, _cop;
+    Memory *_memory;
+  };
+  ForceConst<float> force_const_single;
+  ForceConst<double> force_const_double;
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
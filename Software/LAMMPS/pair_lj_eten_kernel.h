@@ -0,0 +1,263 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   kernels shared by pair style lj/eten and the exponent templated
+   lj/eten/12_10 and lj/eten/12_6, included by their source files only
+------------------------------------------------------------------------- */
+
+#ifndef LMP_PAIR_LJ_ETEN_KERNEL_H
+#define LMP_PAIR_LJ_ETEN_KERNEL_H
+
+#include "pair_lj_eten.h"
+
+#include "atom.h"
+#include "force.h"
+#include "neigh_list.h"
+
+#include <cmath>
+
+namespace LAMMPS_NS {
+namespace LJETEN {
+
+enum { RESPA_INNER, RESPA_MIDDLE, RESPA_OUTER };
+
+/* ----------------------------------------------------------------------
+   r^-N from r^-2 and, for odd N, r^-1 by repeated squaring
+------------------------------------------------------------------------- */
+
+template <int N> inline double inv_pow(double r2inv, double rinv)
+{
+  if constexpr (N == 0) return 1.0;
+  else if constexpr (N % 2) return rinv * inv_pow<N - 1>(r2inv, rinv);
+  else if constexpr (N == 2) return r2inv;
+  else if constexpr (N % 4 == 0) {
+    const double h = inv_pow<N / 2>(r2inv, rinv);
+    return h * h;
+  } else return r2inv * inv_pow<N - 2>(r2inv, rinv);
+}
+
+/* ----------------------------------------------------------------------
+   the powers of one pair. each term is built from the next smaller one
+   by the exponent difference, so the chain shares all intermediates.
+------------------------------------------------------------------------- */
+
+template <int N1, int N2, int N3> struct Powers {
+  static_assert((N1 > N2) && (N2 >= 0) && ((N3 == 0) || (N2 > N3)),
+                "lj/eten exponents must decrease, absent terms last");
+  static constexpr bool ODD = (N1 | N2 | N3) & 1;
+
+  double r2inv, t1, t2, t3;
+
+  explicit Powers(double rsq)
+  {
+    r2inv = 1.0 / rsq;
+    const double rinv = ODD ? sqrt(r2inv) : 0.0;
+    t2 = t3 = 0.0;
+    if constexpr (N3 > 0) {
+      t3 = inv_pow<N3>(r2inv, rinv);
+      t2 = t3 * inv_pow<N2 - N3>(r2inv, rinv);
+      t1 = t2 * inv_pow<N1 - N2>(r2inv, rinv);
+    } else if constexpr (N2 > 0) {
+      t2 = inv_pow<N2>(r2inv, rinv);
+      t1 = t2 * inv_pow<N1 - N2>(r2inv, rinv);
+    } else
+      t1 = inv_pow<N1>(r2inv, rinv);
+  }
+
+  // -r dU/dr and U of the parameter record
+
+  template <class P> double force(const P &p) const
+  {
+    double forcelj = p.lj1 * t1;
+    if constexpr (N2 > 0) forcelj -= p.lj2 * t2;
+    if constexpr (N3 > 0) forcelj += p.lj3 * t3;
+    return forcelj;
+  }
+
+  template <class P> double energy(const P &p) const
+  {
+    double philj = p.lj4 * t1;
+    if constexpr (N2 > 0) philj -= p.lj5 * t2;
+    if constexpr (N3 > 0) philj += p.lj6 * t3;
+    return philj - p.offset;
+  }
+};
+
+}    // namespace LJETEN
+
+/* ----------------------------------------------------------------------
+   one kernel for all rRESPA levels. each pair computes its powers and
+   the unswitched force once, and sqrt(rsq) only when it lies in a
+   switching region of the level. the outer level tallies the full,
+   unswitched pair force into the virial, like compute() would.
+   N1 N2 N3 are the exponents of the A, B, C terms.
+------------------------------------------------------------------------- */
+
+template <int N1, int N2, int N3, int LEVEL, int EVFLAG, int EFLAG, int VFLAG, int STATS>
+void PairLJETEN::eval_respa()
+{
+  using namespace LJETEN;
+
+  int i, j, ii, jj, inum, jnum, itype, jtype;
+  double xtmp, ytmp, ztmp, delx, dely, delz, evdwl, fpair, fswitch;
+  double rsq, factor_lj, rsw, weight;
+  int *ilist, *jlist, *numneigh, **firstneigh;
+  Param *parami;
+  bigint nvisited = 0, ninside = 0, nspecial = 0;
+
+  evdwl = 0.0;
+
+  double **x = atom->x;
+  double **f = atom->f;
+  int *type = atom->type;
+  int nlocal = atom->nlocal;
+  double special_lj[4];
+  scaled_special(special_lj);
+  int newton_pair = force->newton_pair;
+
+  if (LEVEL == RESPA_INNER) {
+    inum = list->inum_inner;
+    ilist = list->ilist_inner;
+    numneigh = list->numneigh_inner;
+    firstneigh = list->firstneigh_inner;
+  } else if (LEVEL == RESPA_MIDDLE) {
+    inum = list->inum_middle;
+    ilist = list->ilist_middle;
+    numneigh = list->numneigh_middle;
+    firstneigh = list->firstneigh_middle;
+  } else {
+    inum = list->inum;
+    ilist = list->ilist;
+    numneigh = list->numneigh;
+    firstneigh = list->firstneigh;
+  }
+
+  // the level switches on between cut_in_off and cut_in_on
+  // and off between cut_out_on and cut_out_off
+
+  double cut_in_off = 0.0, cut_in_on = 0.0, cut_out_on = 0.0, cut_out_off = 0.0;
+  if (LEVEL == RESPA_INNER) {
+    cut_out_on = cut_respa[0];
+    cut_out_off = cut_respa[1];
+  } else if (LEVEL == RESPA_MIDDLE) {
+    cut_in_off = cut_respa[0];
+    cut_in_on = cut_respa[1];
+    cut_out_on = cut_respa[2];
+    cut_out_off = cut_respa[3];
+  } else {
+    cut_in_off = cut_respa[2];
+    cut_in_on = cut_respa[3];
+  }
+
+  const double cut_in_diffinv = (LEVEL != RESPA_INNER) ? 1.0 / (cut_in_on - cut_in_off) : 0.0;
+  const double cut_out_diffinv = (LEVEL != RESPA_OUTER) ? 1.0 / (cut_out_off - cut_out_on) : 0.0;
+  const double cut_in_off_sq = cut_in_off * cut_in_off;
+  const double cut_in_on_sq = cut_in_on * cut_in_on;
+  const double cut_out_on_sq = cut_out_on * cut_out_on;
+  const double cut_out_off_sq = cut_out_off * cut_out_off;
+
+  // loop over neighbors of my atoms
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    xtmp = x[i][0];
+    ytmp = x[i][1];
+    ztmp = x[i][2];
+    itype = type[i];
+    parami = params[itype];
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+    if (STATS) nvisited += jnum;
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      factor_lj = special_lj[sbmask(j)];
+      j &= NEIGHMASK;
+
+      delx = xtmp - x[j][0];
+      dely = ytmp - x[j][1];
+      delz = ztmp - x[j][2];
+      rsq = delx * delx + dely * dely + delz * delz;
+      jtype = type[j];
+
+      // skip pairs outside the range of this level
+
+      if (LEVEL == RESPA_INNER) {
+        if (rsq >= cut_out_off_sq) continue;
+      } else if (LEVEL == RESPA_MIDDLE) {
+        if (rsq >= cut_out_off_sq || rsq <= cut_in_off_sq) continue;
+      } else {
+        if (rsq >= parami[jtype].cutsq) continue;
+        if (STATS) {
+          ninside++;
+          if (factor_lj != 1.0) nspecial++;
+        }
+
+        // pairs of the inner levels only remain for the tallies
+
+        if (!EVFLAG && (rsq <= cut_in_off_sq)) continue;
+      }
+
+      const Param &p = parami[jtype];
+      const Powers<N1, N2, N3> pw(rsq);
+      fpair = factor_lj * pw.force(p) * pw.r2inv;
+
+      weight = 1.0;
+      if ((LEVEL == RESPA_OUTER) && (rsq <= cut_in_off_sq))
+        weight = 0.0;
+      else {
+        const bool switch_on = (LEVEL != RESPA_INNER) && (rsq < cut_in_on_sq);
+        const bool switch_off = (LEVEL != RESPA_OUTER) && (rsq > cut_out_on_sq);
+        if (switch_on || switch_off) {
+          const double r = sqrt(rsq);
+          if (switch_on) {
+            rsw = (r - cut_in_off) * cut_in_diffinv;
+            weight = rsw * rsw * (3.0 - 2.0 * rsw);
+          }
+          if (switch_off) {
+            rsw = (r - cut_out_on) * cut_out_diffinv;
+            weight *= 1.0 - rsw * rsw * (3.0 - 2.0 * rsw);
+          }
+        }
+      }
+
+      if (weight != 0.0) {
+        fswitch = weight * fpair;
+        f[i][0] += delx * fswitch;
+        f[i][1] += dely * fswitch;
+        f[i][2] += delz * fswitch;
+        if (newton_pair || j < nlocal) {
+          f[j][0] -= delx * fswitch;
+          f[j][1] -= dely * fswitch;
+          f[j][2] -= delz * fswitch;
+        }
+      }
+
+      if (EVFLAG) {
+        if (EFLAG) evdwl = factor_lj * pw.energy(p);
+        ev_tally(i, j, nlocal, newton_pair, evdwl, 0.0, VFLAG ? fpair : 0.0, delx, dely, delz);
+      }
+    }
+  }
+
+  if (STATS) {
+    stats_local[STAT_VISITED] += nvisited;
+    stats_local[STAT_INSIDE] += ninside;
+    stats_local[STAT_SPECIAL] += nspecial;
+  }
+}
+
+}    // namespace LAMMPS_NS
+
+#endif
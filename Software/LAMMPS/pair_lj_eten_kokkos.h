@@ -0,0 +1,120 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   KOKKOS version of pair style lj/eten, modeled after lj/cut/kk
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(lj/eten/kk,PairLJETENKokkos<LMPDeviceType>);
+PairStyle(lj/eten/kk/device,PairLJETENKokkos<LMPDeviceType>);
+PairStyle(lj/eten/kk/host,PairLJETENKokkos<LMPHostType>);
+// clang-format on
+#else
+
+// clang-format off
+#ifndef LMP_PAIR_LJ_ETEN_KOKKOS_H
+#define LMP_PAIR_LJ_ETEN_KOKKOS_H
+
+#include "pair_kokkos.h"
+#include "pair_lj_eten.h"
+#include "neigh_list_kokkos.h"
+
+namespace LAMMPS_NS {
+
+template<class DeviceType>
+class PairLJETENKokkos : public PairLJETEN {
+ public:
+  enum {EnabledNeighFlags=FULL|HALFTHREAD|HALF};
+  enum {COUL_FLAG=0};
+  typedef DeviceType device_type;
+  typedef ArrayTypes<DeviceType> AT;
+  PairLJETENKokkos(class LAMMPS *);
+  ~PairLJETENKokkos() override;
+
+  void compute(int, int) override;
+
+  void init_style() override;
+  double init_one(int, int) override;
+  bool energy_sets_supported() const override { return false; }
+
+  struct params_lj{
+    KOKKOS_INLINE_FUNCTION
+    params_lj() {cutsq=0;lj1=0;lj2=0;lj3=0;lj4=0;lj5=0;lj6=0;offset=0;};
+    KOKKOS_INLINE_FUNCTION
+    params_lj(int /*i*/) {cutsq=0;lj1=0;lj2=0;lj3=0;lj4=0;lj5=0;lj6=0;offset=0;};
+    F_FLOAT cutsq,lj1,lj2,lj3,lj4,lj5,lj6,offset;
+  };
+
+ protected:
+  template<bool STACKPARAMS, class Specialisation>
+  KOKKOS_INLINE_FUNCTION
+  F_FLOAT compute_fpair(const F_FLOAT& rsq, const int& i, const int&j, const int& itype, const int& jtype) const;
+
+  template<bool STACKPARAMS, class Specialisation>
+  KOKKOS_INLINE_FUNCTION
+  F_FLOAT compute_evdwl(const F_FLOAT& rsq, const int& i, const int&j, const int& itype, const int& jtype) const;
+
+  template<bool STACKPARAMS, class Specialisation>
+  KOKKOS_INLINE_FUNCTION
+  F_FLOAT compute_ecoul(const F_FLOAT& /*rsq*/, const int& /*i*/, const int& /*j*/,
+                        const int& /*itype*/, const int& /*jtype*/) const { return 0; }
+
+  // device copy of the per type pair parameters; named d_params so it
+  // does not hide the host side PairLJETEN::params table it mirrors
+
+  Kokkos::DualView<params_lj**,Kokkos::LayoutRight,DeviceType> k_params;
+  typename Kokkos::DualView<params_lj**,Kokkos::LayoutRight,DeviceType>::t_dev_const_um d_params;
+  params_lj m_params[MAX_TYPES_STACKPARAMS+1][MAX_TYPES_STACKPARAMS+1];  // hardwired to space for 12 atom types
+  F_FLOAT m_cutsq[MAX_TYPES_STACKPARAMS+1][MAX_TYPES_STACKPARAMS+1];
+  typename AT::t_x_array_randomread x;
+  typename AT::t_x_array c_x;
+  typename AT::t_f_array f;
+  typename AT::t_int_1d_randomread type;
+
+  DAT::tdual_efloat_1d k_eatom;
+  DAT::tdual_virial_array k_vatom;
+  typename AT::t_efloat_1d d_eatom;
+  typename AT::t_virial_array d_vatom;
+
+  int newton_pair;
+  double special_lj[4];
+
+  DAT::tdual_ffloat_2d k_cutsq;
+  typename AT::t_ffloat_2d d_cutsq;
+
+  int neighflag;
+  int nlocal,nall,eflag,vflag;
+
+  void allocate() override;
+  friend struct PairComputeFunctor<PairLJETENKokkos,FULL,true,0>;
+  friend struct PairComputeFunctor<PairLJETENKokkos,FULL,true,1>;
+  friend struct PairComputeFunctor<PairLJETENKokkos,HALF,true>;
+  friend struct PairComputeFunctor<PairLJETENKokkos,HALFTHREAD,true>;
+  friend struct PairComputeFunctor<PairLJETENKokkos,FULL,false,0>;
+  friend struct PairComputeFunctor<PairLJETENKokkos,FULL,false,1>;
+  friend struct PairComputeFunctor<PairLJETENKokkos,HALF,false>;
+  friend struct PairComputeFunctor<PairLJETENKokkos,HALFTHREAD,false>;
+  friend EV_FLOAT pair_compute_neighlist<PairLJETENKokkos,FULL,0>(PairLJETENKokkos*,NeighListKokkos<DeviceType>*);
+  friend EV_FLOAT pair_compute_neighlist<PairLJETENKokkos,FULL,1>(PairLJETENKokkos*,NeighListKokkos<DeviceType>*);
+  friend EV_FLOAT pair_compute_neighlist<PairLJETENKokkos,HALF>(PairLJETENKokkos*,NeighListKokkos<DeviceType>*);
+  friend EV_FLOAT pair_compute_neighlist<PairLJETENKokkos,HALFTHREAD>(PairLJETENKokkos*,NeighListKokkos<DeviceType>*);
+  friend EV_FLOAT pair_compute<PairLJETENKokkos>(PairLJETENKokkos*,NeighListKokkos<DeviceType>*);
+  friend void pair_virial_fdotr_compute<PairLJETENKokkos>(PairLJETENKokkos*);
+};
+
+}
+
+#endif
+#endif
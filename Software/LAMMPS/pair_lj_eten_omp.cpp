@@ -0,0 +1,529 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   OpenMP threaded version of pair style lj/eten,
+   following the pattern of the OPENMP package pair styles
+------------------------------------------------------------------------- */
+
+#include "pair_lj_eten_omp.h"
+
+#include "atom.h"
+#include "comm.h"
+#include "force.h"
+#include "neigh_list.h"
+#include "suffix.h"
+
+#include <cmath>
+
+#include "omp_compat.h"
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+PairLJETENOMP::PairLJETENOMP(LAMMPS *lmp) :
+  PairLJETEN(lmp), ThrOMP(lmp, THR_PAIR)
+{
+  suffix_flag |= Suffix::OMP;
+  scale_in_kernel = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairLJETENOMP::compute(int eflag, int vflag)
+{
+  ev_init(eflag,vflag);
+
+  const int nall = atom->nlocal + atom->nghost;
+  const int nthreads = comm->nthreads;
+  const int inum = list->inum;
+
+#if defined(_OPENMP)
+#pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(eflag,vflag)
+#endif
+  {
+    int ifrom, ito, tid;
+
+    loop_setup_thr(ifrom, ito, tid, inum, nthreads);
+    ThrData *thr = fix->get_thr(tid);
+    thr->timer(Timer::START);
+    ev_setup_thr(eflag, vflag, nall, eatom, vatom, nullptr, thr);
+
+    if (evflag) {
+      if (eflag) {
+        if (force->newton_pair) eval<1,1,1>(ifrom, ito, thr);
+        else eval<1,1,0>(ifrom, ito, thr);
+      } else {
+        if (force->newton_pair) eval<1,0,1>(ifrom, ito, thr);
+        else eval<1,0,0>(ifrom, ito, thr);
+      }
+    } else {
+      if (force->newton_pair) eval<0,0,1>(ifrom, ito, thr);
+      else eval<0,0,0>(ifrom, ito, thr);
+    }
+
+    thr->timer(Timer::PAIR);
+    reduce_thr(this, eflag, vflag, thr);
+  } // end of omp parallel region
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <int EVFLAG, int EFLAG, int NEWTON_PAIR>
+void PairLJETENOMP::eval(int iifrom, int iito, ThrData * const thr)
+{
+  const auto * _noalias const x = (dbl3_t *) atom->x[0];
+  auto * _noalias const f = (dbl3_t *) thr->get_f()[0];
+  const int * _noalias const type = atom->type;
+  const double * _noalias const special_lj = force->special_lj;
+  const int * _noalias const ilist = list->ilist;
+  const int * _noalias const numneigh = list->numneigh;
+  const int * const * const firstneigh = list->firstneigh;
+
+  double xtmp,ytmp,ztmp,delx,dely,delz,fxtmp,fytmp,fztmp;
+  double rsq,r2inv,r4inv,r6inv,forcelj,factor_lj,evdwl,fpair;
+
+  const int nlocal = atom->nlocal;
+  int j,jj,jnum,jtype;
+
+  evdwl = 0.0;
+
+  // loop over neighbors of my atoms
+
+  for (int ii = iifrom; ii < iito; ++ii) {
+    const int i = ilist[ii];
+    const int itype = type[i];
+    const int    * _noalias const jlist = firstneigh[i];
+    const Param  * _noalias const parami = params[itype];
+
+    xtmp = x[i].x;
+    ytmp = x[i].y;
+    ztmp = x[i].z;
+    jnum = numneigh[i];
+    fxtmp=fytmp=fztmp=0.0;
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      factor_lj = special_lj[sbmask(j)];
+      j &= NEIGHMASK;
+
+      delx = xtmp - x[j].x;
+      dely = ytmp - x[j].y;
+      delz = ztmp - x[j].z;
+      rsq = delx*delx + dely*dely + delz*delz;
+      jtype = type[j];
+
+      if (rsq < parami[jtype].cutsq) {
+        r2inv = 1.0/rsq;
+        r4inv = r2inv*r2inv;
+        r6inv = r4inv*r2inv;
+        forcelj = r6inv * (parami[jtype].lj1*r6inv - parami[jtype].lj2*r4inv + parami[jtype].lj3);
+        fpair = factor_lj*forcelj*r2inv;
+
+        fxtmp += delx*fpair;
+        fytmp += dely*fpair;
+        fztmp += delz*fpair;
+        if (NEWTON_PAIR || j < nlocal) {
+          f[j].x -= delx*fpair;
+          f[j].y -= dely*fpair;
+          f[j].z -= delz*fpair;
+        }
+
+        if (EFLAG) {
+          evdwl = r6inv*(parami[jtype].lj4*r6inv - parami[jtype].lj5*r4inv + parami[jtype].lj6) - parami[jtype].offset;
+          evdwl *= factor_lj;
+        }
+
+        if (EVFLAG) ev_tally_thr(this,i,j,nlocal,NEWTON_PAIR,
+                                 evdwl,0.0,fpair,delx,dely,delz,thr);
+      }
+    }
+    f[i].x += fxtmp;
+    f[i].y += fytmp;
+    f[i].z += fztmp;
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairLJETENOMP::compute_inner()
+{
+  const int nall = atom->nlocal + atom->nghost;
+  const int nthreads = comm->nthreads;
+  const int inum = list->inum_inner;
+
+#if defined(_OPENMP)
+#pragma omp parallel LMP_DEFAULT_NONE
+#endif
+  {
+    int ifrom, ito, tid;
+
+    loop_setup_thr(ifrom, ito, tid, inum, nthreads);
+    ThrData *thr = fix->get_thr(tid);
+    thr->timer(Timer::START);
+    ev_setup_thr(0, 0, nall, nullptr, nullptr, nullptr, thr);
+
+    if (force->newton_pair) eval_inner<1>(ifrom, ito, thr);
+    else eval_inner<0>(ifrom, ito, thr);
+
+    thr->timer(Timer::PAIR);
+    reduce_thr(this, 0, 0, thr);
+  } // end of omp parallel region
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <int NEWTON_PAIR>
+void PairLJETENOMP::eval_inner(int iifrom, int iito, ThrData * const thr)
+{
+  const auto * _noalias const x = (dbl3_t *) atom->x[0];
+  auto * _noalias const f = (dbl3_t *) thr->get_f()[0];
+  const int * _noalias const type = atom->type;
+  const double * _noalias const special_lj = force->special_lj;
+  const int * _noalias const ilist = list->ilist_inner;
+  const int * _noalias const numneigh = list->numneigh_inner;
+  const int * const * const firstneigh = list->firstneigh_inner;
+
+  double xtmp,ytmp,ztmp,delx,dely,delz,fxtmp,fytmp,fztmp;
+  double rsq,r2inv,r4inv,r6inv,forcelj,factor_lj,fpair,rsw;
+
+  const int nlocal = atom->nlocal;
+  int j,jj,jnum,jtype;
+
+  const double cut_out_on = cut_respa[0];
+  const double cut_out_off = cut_respa[1];
+
+  const double cut_out_diff = cut_out_off - cut_out_on;
+  const double cut_out_on_sq = cut_out_on*cut_out_on;
+  const double cut_out_off_sq = cut_out_off*cut_out_off;
+
+  // loop over neighbors of my atoms
+
+  for (int ii = iifrom; ii < iito; ++ii) {
+    const int i = ilist[ii];
+    const int itype = type[i];
+    const int    * _noalias const jlist = firstneigh[i];
+    const Param  * _noalias const parami = params[itype];
+
+    xtmp = x[i].x;
+    ytmp = x[i].y;
+    ztmp = x[i].z;
+    jnum = numneigh[i];
+    fxtmp=fytmp=fztmp=0.0;
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      factor_lj = special_lj[sbmask(j)];
+      j &= NEIGHMASK;
+
+      delx = xtmp - x[j].x;
+      dely = ytmp - x[j].y;
+      delz = ztmp - x[j].z;
+      rsq = delx*delx + dely*dely + delz*delz;
+
+      if (rsq < cut_out_off_sq) {
+        r2inv = 1.0/rsq;
+        r4inv = r2inv*r2inv;
+        r6inv = r4inv*r2inv;
+        jtype = type[j];
+        forcelj = r6inv * (parami[jtype].lj1*r6inv - parami[jtype].lj2*r4inv + parami[jtype].lj3);
+        fpair = factor_lj*forcelj*r2inv;
+        if (rsq > cut_out_on_sq) {
+          rsw = (sqrt(rsq) - cut_out_on)/cut_out_diff;
+          fpair *= 1.0 - rsw*rsw*(3.0 - 2.0*rsw);
+        }
+
+        fxtmp += delx*fpair;
+        fytmp += dely*fpair;
+        fztmp += delz*fpair;
+        if (NEWTON_PAIR || j < nlocal) {
+          f[j].x -= delx*fpair;
+          f[j].y -= dely*fpair;
+          f[j].z -= delz*fpair;
+        }
+      }
+    }
+    f[i].x += fxtmp;
+    f[i].y += fytmp;
+    f[i].z += fztmp;
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairLJETENOMP::compute_middle()
+{
+  const int nall = atom->nlocal + atom->nghost;
+  const int nthreads = comm->nthreads;
+  const int inum = list->inum_middle;
+
+#if defined(_OPENMP)
+#pragma omp parallel LMP_DEFAULT_NONE
+#endif
+  {
+    int ifrom, ito, tid;
+
+    loop_setup_thr(ifrom, ito, tid, inum, nthreads);
+    ThrData *thr = fix->get_thr(tid);
+    thr->timer(Timer::START);
+    ev_setup_thr(0, 0, nall, nullptr, nullptr, nullptr, thr);
+
+    if (force->newton_pair) eval_middle<1>(ifrom, ito, thr);
+    else eval_middle<0>(ifrom, ito, thr);
+
+    thr->timer(Timer::PAIR);
+    reduce_thr(this, 0, 0, thr);
+  } // end of omp parallel region
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <int NEWTON_PAIR>
+void PairLJETENOMP::eval_middle(int iifrom, int iito, ThrData * const thr)
+{
+  const auto * _noalias const x = (dbl3_t *) atom->x[0];
+  auto * _noalias const f = (dbl3_t *) thr->get_f()[0];
+  const int * _noalias const type = atom->type;
+  const double * _noalias const special_lj = force->special_lj;
+  const int * _noalias const ilist = list->ilist_middle;
+  const int * _noalias const numneigh = list->numneigh_middle;
+  const int * const * const firstneigh = list->firstneigh_middle;
+
+  double xtmp,ytmp,ztmp,delx,dely,delz,fxtmp,fytmp,fztmp;
+  double rsq,r2inv,r4inv,r6inv,forcelj,factor_lj,fpair,rsw;
+
+  const int nlocal = atom->nlocal;
+  int j,jj,jnum,jtype;
+
+  const double cut_in_off = cut_respa[0];
+  const double cut_in_on = cut_respa[1];
+  const double cut_out_on = cut_respa[2];
+  const double cut_out_off = cut_respa[3];
+
+  const double cut_in_diff = cut_in_on - cut_in_off;
+  const double cut_out_diff = cut_out_off - cut_out_on;
+  const double cut_in_off_sq = cut_in_off*cut_in_off;
+  const double cut_in_on_sq = cut_in_on*cut_in_on;
+  const double cut_out_on_sq = cut_out_on*cut_out_on;
+  const double cut_out_off_sq = cut_out_off*cut_out_off;
+
+  // loop over neighbors of my atoms
+
+  for (int ii = iifrom; ii < iito; ++ii) {
+    const int i = ilist[ii];
+    const int itype = type[i];
+    const int    * _noalias const jlist = firstneigh[i];
+    const Param  * _noalias const parami = params[itype];
+
+    xtmp = x[i].x;
+    ytmp = x[i].y;
+    ztmp = x[i].z;
+    jnum = numneigh[i];
+    fxtmp=fytmp=fztmp=0.0;
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      factor_lj = special_lj[sbmask(j)];
+      j &= NEIGHMASK;
+
+      delx = xtmp - x[j].x;
+      dely = ytmp - x[j].y;
+      delz = ztmp - x[j].z;
+      rsq = delx*delx + dely*dely + delz*delz;
+
+      if (rsq < cut_out_off_sq && rsq > cut_in_off_sq) {
+        r2inv = 1.0/rsq;
+        r4inv = r2inv*r2inv;
+        r6inv = r4inv*r2inv;
+        jtype = type[j];
+        forcelj = r6inv * (parami[jtype].lj1*r6inv - parami[jtype].lj2*r4inv + parami[jtype].lj3);
+        fpair = factor_lj*forcelj*r2inv;
+        if (rsq < cut_in_on_sq) {
+          rsw = (sqrt(rsq) - cut_in_off)/cut_in_diff;
+          fpair *= rsw*rsw*(3.0 - 2.0*rsw);
+        }
+        if (rsq > cut_out_on_sq) {
+          rsw = (sqrt(rsq) - cut_out_on)/cut_out_diff;
+          fpair *= 1.0 + rsw*rsw*(2.0*rsw - 3.0);
+        }
+
+        fxtmp += delx*fpair;
+        fytmp += dely*fpair;
+        fztmp += delz*fpair;
+        if (NEWTON_PAIR || j < nlocal) {
+          f[j].x -= delx*fpair;
+          f[j].y -= dely*fpair;
+          f[j].z -= delz*fpair;
+        }
+      }
+    }
+    f[i].x += fxtmp;
+    f[i].y += fytmp;
+    f[i].z += fztmp;
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairLJETENOMP::compute_outer(int eflag, int vflag)
+{
+  ev_init(eflag,vflag);
+
+  const int nall = atom->nlocal + atom->nghost;
+  const int nthreads = comm->nthreads;
+  const int inum = list->inum;
+
+#if defined(_OPENMP)
+#pragma omp parallel LMP_DEFAULT_NONE LMP_SHARED(eflag,vflag)
+#endif
+  {
+    int ifrom, ito, tid;
+
+    loop_setup_thr(ifrom, ito, tid, inum, nthreads);
+    ThrData *thr = fix->get_thr(tid);
+    thr->timer(Timer::START);
+    ev_setup_thr(eflag, vflag, nall, eatom, vatom, nullptr, thr);
+
+    if (evflag) {
+      if (eflag) {
+        if (vflag) {
+          if (force->newton_pair) eval_outer<1,1,1,1>(ifrom, ito, thr);
+          else eval_outer<1,1,1,0>(ifrom, ito, thr);
+        } else {
+          if (force->newton_pair) eval_outer<1,1,0,1>(ifrom, ito, thr);
+          else eval_outer<1,1,0,0>(ifrom, ito, thr);
+        }
+      } else {
+        if (force->newton_pair) eval_outer<1,0,1,1>(ifrom, ito, thr);
+        else eval_outer<1,0,1,0>(ifrom, ito, thr);
+      }
+    } else {
+      if (force->newton_pair) eval_outer<0,0,0,1>(ifrom, ito, thr);
+      else eval_outer<0,0,0,0>(ifrom, ito, thr);
+    }
+
+    thr->timer(Timer::PAIR);
+    reduce_thr(this, eflag, vflag, thr);
+  } // end of omp parallel region
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <int EVFLAG, int EFLAG, int VFLAG, int NEWTON_PAIR>
+void PairLJETENOMP::eval_outer(int iifrom, int iito, ThrData * const thr)
+{
+  const auto * _noalias const x = (dbl3_t *) atom->x[0];
+  auto * _noalias const f = (dbl3_t *) thr->get_f()[0];
+  const int * _noalias const type = atom->type;
+  const double * _noalias const special_lj = force->special_lj;
+  const int * _noalias const ilist = list->ilist;
+  const int * _noalias const numneigh = list->numneigh;
+  const int * const * const firstneigh = list->firstneigh;
+
+  double xtmp,ytmp,ztmp,delx,dely,delz,fxtmp,fytmp,fztmp;
+  double rsq,r2inv,r4inv,r6inv,forcelj,factor_lj,evdwl,fpair,fswitch,rsw;
+
+  const int nlocal = atom->nlocal;
+  int j,jj,jnum,jtype;
+
+  const double cut_in_off = cut_respa[2];
+  const double cut_in_on = cut_respa[3];
+
+  const double cut_in_diff = cut_in_on - cut_in_off;
+  const double cut_in_off_sq = cut_in_off*cut_in_off;
+  const double cut_in_on_sq = cut_in_on*cut_in_on;
+
+  evdwl = 0.0;
+  fpair = 0.0;
+
+  // loop over neighbors of my atoms
+
+  for (int ii = iifrom; ii < iito; ++ii) {
+    const int i = ilist[ii];
+    const int itype = type[i];
+    const int    * _noalias const jlist = firstneigh[i];
+    const Param  * _noalias const parami = params[itype];
+
+    xtmp = x[i].x;
+    ytmp = x[i].y;
+    ztmp = x[i].z;
+    jnum = numneigh[i];
+    fxtmp=fytmp=fztmp=0.0;
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      factor_lj = special_lj[sbmask(j)];
+      j &= NEIGHMASK;
+
+      delx = xtmp - x[j].x;
+      dely = ytmp - x[j].y;
+      delz = ztmp - x[j].z;
+      rsq = delx*delx + dely*dely + delz*delz;
+      jtype = type[j];
+
+      if (rsq < parami[jtype].cutsq) {
+        r2inv = 1.0/rsq;
+        r4inv = r2inv*r2inv;
+        r6inv = r4inv*r2inv;
+
+        // the outer level applies the switched force beyond the inner cutoff,
+        // but tallies the full pair force into the virial
+
+        if (rsq > cut_in_off_sq || VFLAG) {
+          forcelj = r6inv * (parami[jtype].lj1*r6inv - parami[jtype].lj2*r4inv + parami[jtype].lj3);
+          fpair = factor_lj*forcelj*r2inv;
+        }
+
+        if (rsq > cut_in_off_sq) {
+          fswitch = fpair;
+          if (rsq < cut_in_on_sq) {
+            rsw = (sqrt(rsq) - cut_in_off)/cut_in_diff;
+            fswitch *= rsw*rsw*(3.0 - 2.0*rsw);
+          }
+
+          fxtmp += delx*fswitch;
+          fytmp += dely*fswitch;
+          fztmp += delz*fswitch;
+          if (NEWTON_PAIR || j < nlocal) {
+            f[j].x -= delx*fswitch;
+            f[j].y -= dely*fswitch;
+            f[j].z -= delz*fswitch;
+          }
+          if (!VFLAG) fpair = fswitch;
+        }
+
+        if (EFLAG) {
+          evdwl = r6inv*(parami[jtype].lj4*r6inv - parami[jtype].lj5*r4inv + parami[jtype].lj6) - parami[jtype].offset;
+          evdwl *= factor_lj;
+        }
+
+        if (EVFLAG) ev_tally_thr(this,i,j,nlocal,NEWTON_PAIR,
+                                 evdwl,0.0,fpair,delx,dely,delz,thr);
+      }
+    }
+    f[i].x += fxtmp;
+    f[i].y += fytmp;
+    f[i].z += fztmp;
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+double PairLJETENOMP::memory_usage()
+{
+  double bytes = memory_usage_thr();
+  bytes += PairLJETEN::memory_usage();
+
+  return bytes;
+}
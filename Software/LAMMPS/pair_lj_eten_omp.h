@@ -0,0 +1,56 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   OpenMP threaded version of pair style lj/eten,
+   to be built together with the OPENMP package
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(lj/eten/omp,PairLJETENOMP);
+// clang-format on
+#else
+
+#ifndef LMP_PAIR_LJ_ETEN_OMP_H
+#define LMP_PAIR_LJ_ETEN_OMP_H
+
+#include "pair_lj_eten.h"
+#include "thr_omp.h"
+
+namespace LAMMPS_NS {
+
+class PairLJETENOMP : public PairLJETEN, public ThrOMP {
+
+ public:
+  PairLJETENOMP(class LAMMPS *);
+
+  void compute(int, int) override;
+  void compute_inner() override;
+  void compute_middle() override;
+  void compute_outer(int, int) override;
+  double memory_usage() override;
+
+ private:
+  template <int EVFLAG, int EFLAG, int NEWTON_PAIR>
+  void eval(int ifrom, int ito, ThrData *const thr);
+  template <int NEWTON_PAIR> void eval_inner(int ifrom, int ito, ThrData *const thr);
+  template <int NEWTON_PAIR> void eval_middle(int ifrom, int ito, ThrData *const thr);
+  template <int EVFLAG, int EFLAG, int VFLAG, int NEWTON_PAIR>
+  void eval_outer(int ifrom, int ito, ThrData *const thr);
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
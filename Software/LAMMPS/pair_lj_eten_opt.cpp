@@ -0,0 +1,184 @@
+// clang-format off
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   Optimized version of pair style lj/eten,
+   modeled after pair style lj/cut/opt of the OPT package
+------------------------------------------------------------------------- */
+
+#include "pair_lj_eten_opt.h"
+
+#include "atom.h"
+#include "force.h"
+#include "neigh_list.h"
+#include "suffix.h"
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+PairLJETENOpt::PairLJETENOpt(LAMMPS *lmp) : PairLJETEN(lmp)
+{
+  suffix_flag |= Suffix::OPT;
+  scale_in_kernel = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairLJETENOpt::compute(int eflag, int vflag)
+{
+  ev_init(eflag,vflag);
+
+  if (evflag) {
+    if (eflag) {
+      if (force->newton_pair) return eval<1,1,1>();
+      else return eval<1,1,0>();
+    } else {
+      if (force->newton_pair) return eval<1,0,1>();
+      else return eval<1,0,0>();
+    }
+  } else {
+    if (force->newton_pair) return eval<0,0,1>();
+    else return eval<0,0,0>();
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+template < int EVFLAG, int EFLAG, int NEWTON_PAIR >
+void PairLJETENOpt::eval()
+{
+  typedef struct { double x,y,z; } vec3_t;
+
+  int i,j,ii,jj,inum,jnum,itype,jtype,sbindex;
+  double factor_lj;
+  double evdwl = 0.0;
+
+  double** _noalias x = atom->x;
+  double** _noalias f = atom->f;
+  int* _noalias type = atom->type;
+  int nlocal = atom->nlocal;
+  double* _noalias special_lj = force->special_lj;
+
+  inum = list->inum;
+  int* _noalias ilist = list->ilist;
+  int** _noalias firstneigh = list->firstneigh;
+  int* _noalias numneigh = list->numneigh;
+
+  vec3_t* _noalias xx = (vec3_t*)x[0];
+  vec3_t* _noalias ff = (vec3_t*)f[0];
+
+  // the packed per type pair records of the base class already have
+  // the one-cache-line layout, so no local copy of the tables is needed
+
+  // loop over neighbors of my atoms
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    double xtmp = xx[i].x;
+    double ytmp = xx[i].y;
+    double ztmp = xx[i].z;
+    itype = type[i];
+    int* _noalias jlist = firstneigh[i];
+    jnum = numneigh[i];
+
+    double tmpfx = 0.0;
+    double tmpfy = 0.0;
+    double tmpfz = 0.0;
+
+    const Param* _noalias parami = params[itype];
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      sbindex = sbmask(j);
+
+      if (sbindex == 0) {
+        double delx = xtmp - xx[j].x;
+        double dely = ytmp - xx[j].y;
+        double delz = ztmp - xx[j].z;
+        double rsq = delx*delx + dely*dely + delz*delz;
+
+        jtype = type[j];
+
+        const Param& a = parami[jtype];
+
+        if (rsq < a.cutsq) {
+          double r2inv = 1.0/rsq;
+          double r4inv = r2inv*r2inv;
+          double r6inv = r4inv*r2inv;
+          double forcelj = r6inv * (a.lj1*r6inv - a.lj2*r4inv + a.lj3);
+          double fpair = forcelj*r2inv;
+
+          tmpfx += delx*fpair;
+          tmpfy += dely*fpair;
+          tmpfz += delz*fpair;
+          if (NEWTON_PAIR || j < nlocal) {
+            ff[j].x -= delx*fpair;
+            ff[j].y -= dely*fpair;
+            ff[j].z -= delz*fpair;
+          }
+
+          if (EFLAG) evdwl = r6inv*(a.lj4*r6inv - a.lj5*r4inv + a.lj6) - a.offset;
+
+          if (EVFLAG) ev_tally(i,j,nlocal,NEWTON_PAIR,
+                               evdwl,0.0,fpair,delx,dely,delz);
+        }
+
+      } else {
+        factor_lj = special_lj[sbindex];
+        j &= NEIGHMASK;
+
+        double delx = xtmp - xx[j].x;
+        double dely = ytmp - xx[j].y;
+        double delz = ztmp - xx[j].z;
+        double rsq = delx*delx + dely*dely + delz*delz;
+
+        jtype = type[j];
+
+        const Param& a = parami[jtype];
+
+        if (rsq < a.cutsq) {
+          double r2inv = 1.0/rsq;
+          double r4inv = r2inv*r2inv;
+          double r6inv = r4inv*r2inv;
+          double forcelj = r6inv * (a.lj1*r6inv - a.lj2*r4inv + a.lj3);
+          double fpair = factor_lj*forcelj*r2inv;
+
+          tmpfx += delx*fpair;
+          tmpfy += dely*fpair;
+          tmpfz += delz*fpair;
+          if (NEWTON_PAIR || j < nlocal) {
+            ff[j].x -= delx*fpair;
+            ff[j].y -= dely*fpair;
+            ff[j].z -= delz*fpair;
+          }
+
+          if (EFLAG) {
+            evdwl = r6inv*(a.lj4*r6inv - a.lj5*r4inv + a.lj6) - a.offset;
+            evdwl *= factor_lj;
+          }
+
+          if (EVFLAG) ev_tally(i,j,nlocal,NEWTON_PAIR,
+                               evdwl,0.0,fpair,delx,dely,delz);
+        }
+      }
+    }
+
+    ff[i].x += tmpfx;
+    ff[i].y += tmpfy;
+    ff[i].z += tmpfz;
+  }
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
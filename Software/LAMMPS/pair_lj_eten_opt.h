@@ -0,0 +1,39 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(lj/eten/opt,PairLJETENOpt);
+// clang-format on
+#else
+
+#ifndef LMP_PAIR_LJ_ETEN_OPT_H
+#define LMP_PAIR_LJ_ETEN_OPT_H
+
+#include "pair_lj_eten.h"
+
+namespace LAMMPS_NS {
+
+class PairLJETENOpt : public PairLJETEN {
+ public:
+  PairLJETENOpt(class LAMMPS *);
+  void compute(int, int) override;
+
+ protected:
+  template <int EVFLAG, int EFLAG, int NEWTON_PAIR> void eval();
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
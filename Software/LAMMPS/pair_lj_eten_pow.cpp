@@ -0,0 +1,265 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   Go model pair styles with exponents fixed at compile time, e.g. the
+   12-10 native contact potential lj/eten/12_10 and lj/eten/12_6.
+   Coefficients are A B C [cut] as for lj/eten, the coefficient of an
+   absent term is ignored. Only the neighbor list mode of lj/eten is
+   available.
+------------------------------------------------------------------------- */
+
+#include "pair_lj_eten_pow.h"
+#include "pair_lj_eten_kernel.h"
+
+#include "atom.h"
+#include "comm.h"
+#include "error.h"
+#include "force.h"
+#include "neigh_list.h"
+
+#include <cmath>
+
+using namespace LAMMPS_NS;
+using namespace LJETEN;
+
+/* ---------------------------------------------------------------------- */
+
+template <int N1, int N2, int N3> PairLJETENPow<N1, N2, N3>::PairLJETENPow(LAMMPS *lmp) : PairLJETEN(lmp)
+{
+  scale_in_kernel = 0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <int N1, int N2, int N3> void PairLJETENPow<N1, N2, N3>::compute(int eflag, int vflag)
+{
+  ev_init(eflag, vflag);
+
+  if (evflag) {
+    if (eflag) {
+      if (force->newton_pair) eval<1, 1, 1>();
+      else eval<1, 1, 0>();
+    } else {
+      if (force->newton_pair) eval<1, 0, 1>();
+      else eval<1, 0, 0>();
+    }
+  } else {
+    if (force->newton_pair) eval<0, 0, 1>();
+    else eval<0, 0, 0>();
+  }
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <int N1, int N2, int N3>
+template <int EVFLAG, int EFLAG, int NEWTON_PAIR>
+void PairLJETENPow<N1, N2, N3>::eval()
+{
+  int i, j, ii, jj, inum, jnum, itype, jtype;
+  double xtmp, ytmp, ztmp, delx, dely, delz, evdwl, fpair;
+  double rsq, factor_lj;
+  int *ilist, *jlist, *numneigh, **firstneigh;
+  Param *parami;
+
+  evdwl = 0.0;
+
+  double **x = atom->x;
+  double **f = atom->f;
+  int *type = atom->type;
+  int nlocal = atom->nlocal;
+  double *special_lj = force->special_lj;
+
+  inum = list->inum;
+  ilist = list->ilist;
+  numneigh = list->numneigh;
+  firstneigh = list->firstneigh;
+
+  // loop over neighbors of my atoms
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    xtmp = x[i][0];
+    ytmp = x[i][1];
+    ztmp = x[i][2];
+    itype = type[i];
+    parami = params[itype];
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      factor_lj = special_lj[sbmask(j)];
+      j &= NEIGHMASK;
+
+      delx = xtmp - x[j][0];
+      dely = ytmp - x[j][1];
+      delz = ztmp - x[j][2];
+      rsq = delx * delx + dely * dely + delz * delz;
+      jtype = type[j];
+
+      if (rsq < parami[jtype].cutsq) {
+        const Param &p = parami[jtype];
+        const Powers<N1, N2, N3> pw(rsq);
+        fpair = factor_lj * pw.force(p) * pw.r2inv;
+
+        f[i][0] += delx * fpair;
+        f[i][1] += dely * fpair;
+        f[i][2] += delz * fpair;
+        if (NEWTON_PAIR || j < nlocal) {
+          f[j][0] -= delx * fpair;
+          f[j][1] -= dely * fpair;
+          f[j][2] -= delz * fpair;
+        }
+
+        if (EFLAG) evdwl = factor_lj * pw.energy(p);
+
+        if (EVFLAG) ev_tally(i, j, nlocal, NEWTON_PAIR, evdwl, 0.0, fpair, delx, dely, delz);
+      }
+    }
+  }
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <int N1, int N2, int N3> void PairLJETENPow<N1, N2, N3>::compute_inner()
+{
+  eval_respa<N1, N2, N3, RESPA_INNER, 0, 0, 0, 0>();
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <int N1, int N2, int N3> void PairLJETENPow<N1, N2, N3>::compute_middle()
+{
+  eval_respa<N1, N2, N3, RESPA_MIDDLE, 0, 0, 0, 0>();
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <int N1, int N2, int N3> void PairLJETENPow<N1, N2, N3>::compute_outer(int eflag, int vflag)
+{
+  ev_init(eflag, vflag);
+
+  if (evflag) {
+    if (eflag_either) {
+      if (vflag_either) eval_respa<N1, N2, N3, RESPA_OUTER, 1, 1, 1, 0>();
+      else eval_respa<N1, N2, N3, RESPA_OUTER, 1, 1, 0, 0>();
+    } else {
+      if (vflag_either) eval_respa<N1, N2, N3, RESPA_OUTER, 1, 0, 1, 0>();
+      else eval_respa<N1, N2, N3, RESPA_OUTER, 1, 0, 0, 0>();
+    }
+  } else eval_respa<N1, N2, N3, RESPA_OUTER, 0, 0, 0, 0>();
+}
+
+/* ----------------------------------------------------------------------
+   init specific to this pair style
+------------------------------------------------------------------------- */
+
+template <int N1, int N2, int N3> void PairLJETENPow<N1, N2, N3>::init_style()
+{
+  if (allpairs_flag || native_flag || residue_flag || sparse_flag || stats_flag || async_flag || compact_flag)
+    error->all(FLERR, "Pair style {} supports no lj/eten keywords", force->pair_style);
+  if (cut_tolerance > 0.0) error->all(FLERR, "Pair style {} does not support pair_modify tolerance", force->pair_style);
+  if (table_bits) error->all(FLERR, "Pair style {} does not support pair_modify table/lj", force->pair_style);
+
+  // coefficients of absent terms are accepted but unused
+
+  if ((N2 == 0) || (N3 == 0)) {
+    int unused = 0;
+    for (int i = 1; i <= atom->ntypes; i++)
+      for (int j = i; j <= atom->ntypes; j++)
+        if (setflag[i][j] && (((N2 == 0) && (bterm[i][j] != 0.0)) || ((N3 == 0) && (cterm[i][j] != 0.0))))
+          unused++;
+    if (unused && (comm->me == 0))
+      error->warning(FLERR, "Pair style {} ignores the coefficients of absent terms of {} type pairs",
+                     force->pair_style, unused);
+  }
+
+  PairLJETEN::init_style();
+}
+
+/* ----------------------------------------------------------------------
+   rederive the parameters of the base class for the exponents
+------------------------------------------------------------------------- */
+
+template <int N1, int N2, int N3> double PairLJETENPow<N1, N2, N3>::init_one(int i, int j)
+{
+  double cut_one = PairLJETEN::init_one(i, j);
+
+  Param &p = params[i][j];
+  p.lj1 = N1 * p.lj4;
+  p.lj2 = N2 * p.lj5;
+  p.lj3 = N3 * p.lj6;
+  p.offset = 0.0;
+  if (offset_flag && (cut_one > 0.0)) {
+    const Powers<N1, N2, N3> pw(cut_one * cut_one);
+    p.offset = pw.energy(p);
+  }
+  params[j][i] = p;
+
+  return cut_one;
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <int N1, int N2, int N3>
+double PairLJETENPow<N1, N2, N3>::single(int /*i*/, int /*j*/, int itype, int jtype, double rsq,
+                                         double /*factor_coul*/, double factor_lj, double &fforce)
+{
+  const Param &p = params[itype][jtype];
+  const Powers<N1, N2, N3> pw(rsq);
+  fforce = factor_lj * pw.force(p) * pw.r2inv;
+  return factor_lj * pw.energy(p);
+}
+
+/* ----------------------------------------------------------------------
+   dU/dr = -(N1 A/r^N1 - N2 B/r^N2 + N3 C/r^N3) / r
+   d2U/dr2 = ((N1+1) N1 A/r^N1 - (N2+1) N2 B/r^N2 + (N3+1) N3 C/r^N3) / r^2
+------------------------------------------------------------------------- */
+
+template <int N1, int N2, int N3>
+void PairLJETENPow<N1, N2, N3>::born_matrix(int /*i*/, int /*j*/, int itype, int jtype, double rsq,
+                                            double /*factor_coul*/, double factor_lj, double &dupair,
+                                            double &du2pair)
+{
+  const Param &p = params[itype][jtype];
+  const Powers<N1, N2, N3> pw(rsq);
+
+  double du2 = (N1 + 1) * p.lj1 * pw.t1;
+  if constexpr (N2 > 0) du2 -= (N2 + 1) * p.lj2 * pw.t2;
+  if constexpr (N3 > 0) du2 += (N3 + 1) * p.lj3 * pw.t3;
+
+  dupair = -factor_lj * pw.force(p) * sqrt(pw.r2inv);
+  du2pair = factor_lj * du2 * pw.r2inv;
+}
+
+/* ---------------------------------------------------------------------- */
+
+template <int N1, int N2, int N3>
+void PairLJETENPow<N1, N2, N3>::single_batch(int n, const int *itype, const int *jtype, const double *rsq,
+                                             const double *factor_lj, double *energy, double *fforce)
+{
+  for (int k = 0; k < n; k++) {
+    const Param &p = params[itype[k]][jtype[k]];
+    const Powers<N1, N2, N3> pw(rsq[k]);
+    energy[k] = factor_lj[k] * pw.energy(p);
+    if (fforce) fforce[k] = factor_lj[k] * pw.force(p) * pw.r2inv;
+  }
+}
+
+namespace LAMMPS_NS {
+template class PairLJETENPow<12, 10, 0>;
+template class PairLJETENPow<12, 6, 0>;
+}    // namespace LAMMPS_NS
@@ -0,0 +1,56 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(lj/eten/12_10,PairLJETEN1210);
+PairStyle(lj/eten/12_6,PairLJETEN126);
+// clang-format on
+#else
+
+#ifndef LMP_PAIR_LJ_ETEN_POW_H
+#define LMP_PAIR_LJ_ETEN_POW_H
+
+#include "pair_lj_eten.h"
+
+namespace LAMMPS_NS {
+
+// U = A/r^N1 - B/r^N2 + C/r^N3 with N1 > N2 > N3, an exponent of 0
+// removes its term at compile time
+
+template <int N1, int N2, int N3> class PairLJETENPow : public PairLJETEN {
+ public:
+  PairLJETENPow(class LAMMPS *);
+  void compute(int, int) override;
+  void compute_inner() override;
+  void compute_middle() override;
+  void compute_outer(int, int) override;
+  void init_style() override;
+  double init_one(int, int) override;
+  double single(int, int, int, int, double, double, double, double &) override;
+  void born_matrix(int, int, int, int, double, double, double, double &, double &) override;
+  void single_batch(int, const int *, const int *, const double *, const double *, double *,
+                    double *) override;
+  bool energy_sets_supported() const override { return false; }
+
+ protected:
+  template <int EVFLAG, int EFLAG, int NEWTON_PAIR> void eval();
+};
+
+typedef PairLJETENPow<12, 10, 0> PairLJETEN1210;
+typedef PairLJETENPow<12, 6, 0> PairLJETEN126;
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
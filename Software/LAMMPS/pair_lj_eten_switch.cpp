@@ -0,0 +1,289 @@
+/* ----------------------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+/* ----------------------------------------------------------------------
+   Force switched version of pair style lj/eten. Each term C_n/r^n is
+   switched separately as in Steinbach and Brooks, J Comp Chem 15, 667
+   (1994), so force and energy go smoothly to zero at the outer cutoff.
+------------------------------------------------------------------------- */
+
+#include "pair_lj_eten_switch.h"
+
+#include "atom.h"
+#include "comm.h"
+#include "error.h"
+#include "force.h"
+#include "neigh_list.h"
+
+#include <cmath>
+#include <cstring>
+
+using namespace LAMMPS_NS;
+
+/* ---------------------------------------------------------------------- */
+
+PairLJETENSwitch::PairLJETENSwitch(LAMMPS *lmp) : PairLJETEN(lmp)
+{
+  respa_enable = 0;
+  born_matrix_enable = 0;
+  scale_in_kernel = 0;
+
+  cut_inner = cut_inner_sq = 0.0;
+}
+
+/* ---------------------------------------------------------------------- */
+
+void PairLJETENSwitch::compute(int eflag, int vflag)
+{
+  // tables of the switched single() are evaluated by the base kernel
+
+  if (table_bits) {
+    PairLJETEN::compute(eflag, vflag);
+    return;
+  }
+
+  int i, j, ii, jj, inum, jnum, itype, jtype;
+  double xtmp, ytmp, ztmp, delx, dely, delz, evdwl, fpair;
+  double rsq, r2inv, r3inv, r4inv, r5inv, r6inv, rinv, forcelj, factor_lj;
+  int *ilist, *jlist, *numneigh, **firstneigh;
+  Param *parami;
+
+  evdwl = 0.0;
+  ev_init(eflag, vflag);
+
+  double **x = atom->x;
+  double **f = atom->f;
+  int *type = atom->type;
+  int nlocal = atom->nlocal;
+  double *special_lj = force->special_lj;
+  int newton_pair = force->newton_pair;
+
+  inum = list->inum;
+  ilist = list->ilist;
+  numneigh = list->numneigh;
+  firstneigh = list->firstneigh;
+
+  // loop over neighbors of my atoms
+
+  for (ii = 0; ii < inum; ii++) {
+    i = ilist[ii];
+    xtmp = x[i][0];
+    ytmp = x[i][1];
+    ztmp = x[i][2];
+    itype = type[i];
+    parami = params[itype];
+    jlist = firstneigh[i];
+    jnum = numneigh[i];
+
+    for (jj = 0; jj < jnum; jj++) {
+      j = jlist[jj];
+      factor_lj = special_lj[sbmask(j)];
+      j &= NEIGHMASK;
+
+      delx = xtmp - x[j][0];
+      dely = ytmp - x[j][1];
+      delz = ztmp - x[j][2];
+      rsq = delx * delx + dely * dely + delz * delz;
+      jtype = type[j];
+
+      if (rsq < parami[jtype].cutsq) {
+        const Param &p = parami[jtype];
+        r2inv = 1.0 / rsq;
+        r4inv = r2inv * r2inv;
+        r6inv = r4inv * r2inv;
+
+        if (rsq > cut_inner_sq) {
+          rinv = sqrt(r2inv);
+          r3inv = r2inv * rinv;
+          r5inv = r4inv * rinv;
+          forcelj = p.lj1 * k12 * r6inv * (r6inv - c6) - p.lj2 * k10 * r5inv * (r5inv - c5) +
+              p.lj3 * k6 * r3inv * (r3inv - c3);
+        } else
+          forcelj = r6inv * (p.lj1 * r6inv - p.lj2 * r4inv + p.lj3);
+        fpair = factor_lj * forcelj * r2inv;
+
+        f[i][0] += delx * fpair;
+        f[i][1] += dely * fpair;
+        f[i][2] += delz * fpair;
+        if (newton_pair || j < nlocal) {
+          f[j][0] -= delx * fpair;
+          f[j][1] -= dely * fpair;
+          f[j][2] -= delz * fpair;
+        }
+
+        if (eflag) {
+          if (rsq > cut_inner_sq)
+            evdwl = p.lj4 * k12 * (r6inv - c6) * (r6inv - c6) -
+                p.lj5 * k10 * (r5inv - c5) * (r5inv - c5) + p.lj6 * k6 * (r3inv - c3) * (r3inv - c3);
+          else
+            evdwl = p.lj4 * (r6inv * r6inv - shift12) - p.lj5 * (r6inv * r4inv - shift10) +
+                p.lj6 * (r6inv - shift6);
+          evdwl *= factor_lj;
+        }
+
+        if (evflag) ev_tally(i, j, nlocal, newton_pair, evdwl, 0.0, fpair, delx, dely, delz);
+      }
+    }
+  }
+
+  if (vflag_fdotr) virial_fdotr_compute();
+}
+
+/* ----------------------------------------------------------------------
+   global settings: inner and outer switching radius
+------------------------------------------------------------------------- */
+
+void PairLJETENSwitch::settings(int narg, char **arg)
+{
+  if (narg != 2) error->all(FLERR, "Illegal pair_style command");
+
+  cut_inner = utils::numeric(FLERR, arg[0], false, lmp);
+  cut_global = utils::numeric(FLERR, arg[1], false, lmp);
+  if (cut_inner <= 0.0 || cut_inner >= cut_global)
+    error->all(FLERR, "Pair style lj/eten/switch requires 0 < inner cutoff < outer cutoff");
+
+  if (allocated) {
+    for (int i = 1; i <= atom->ntypes; i++)
+      for (int j = i; j <= atom->ntypes; j++)
+        if (setflag[i][j]) cut[i][j] = cut_global;
+  }
+}
+
+/* ----------------------------------------------------------------------
+   set coeffs for one or more type pairs, only global cutoffs
+------------------------------------------------------------------------- */
+
+void PairLJETENSwitch::coeff(int narg, char **arg)
+{
+  const int fileflag = (narg >= 3) && (strcmp(arg[2], "file") == 0);
+  if (!fileflag && narg != 5)
+    error->all(FLERR, "Pair style lj/eten/switch does not support per-pair cutoffs");
+  PairLJETEN::coeff(narg, arg);
+
+  // cutoffs from a coefficient file are replaced by the global one
+
+  if (fileflag)
+    for (int i = 1; i <= atom->ntypes; i++)
+      for (int j = i; j <= atom->ntypes; j++)
+        if (setflag[i][j]) cut[i][j] = cut_global;
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 writes all pairs to data file, without the per-pair cutoff
+   that coeff() does not accept
+------------------------------------------------------------------------- */
+
+void PairLJETENSwitch::write_data_all(FILE *fp)
+{
+  for (int i = 1; i <= atom->ntypes; i++)
+    for (int j = i; j <= atom->ntypes; j++)
+      fprintf(fp, "%d %d %g %g %g\n", i, j, aterm[i][j], bterm[i][j], cterm[i][j]);
+}
+
+/* ----------------------------------------------------------------------
+   init specific to this pair style
+------------------------------------------------------------------------- */
+
+void PairLJETENSwitch::init_style()
+{
+  if (cut_tolerance > 0.0)
+    error->all(FLERR, "Pair style lj/eten/switch does not support pair_modify tolerance");
+  if (offset_flag && (comm->me == 0))
+    error->warning(FLERR, "Pair style lj/eten/switch is already zero at the cutoff, ignoring offset");
+
+  PairLJETEN::init_style();
+
+  cut_inner_sq = cut_inner * cut_inner;
+
+  double ron3 = cut_inner * cut_inner * cut_inner;
+  double roff3 = cut_global * cut_global * cut_global;
+  double ron5 = ron3 * cut_inner * cut_inner;
+  double roff5 = roff3 * cut_global * cut_global;
+  double ron6 = ron3 * ron3;
+  double roff6 = roff3 * roff3;
+
+  k12 = roff6 / (roff6 - ron6);
+  k10 = roff5 / (roff5 - ron5);
+  k6 = roff3 / (roff3 - ron3);
+  c6 = 1.0 / roff6;
+  c5 = 1.0 / roff5;
+  c3 = 1.0 / roff3;
+  shift12 = 1.0 / (ron6 * roff6);
+  shift10 = 1.0 / (ron5 * roff5);
+  shift6 = 1.0 / (ron3 * roff3);
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 writes to restart file
+------------------------------------------------------------------------- */
+
+void PairLJETENSwitch::write_restart_settings(FILE *fp)
+{
+  PairLJETEN::write_restart_settings(fp);
+  fwrite(&cut_inner, sizeof(double), 1, fp);
+}
+
+/* ----------------------------------------------------------------------
+   proc 0 reads from restart file, bcasts
+------------------------------------------------------------------------- */
+
+void PairLJETENSwitch::read_restart_settings(FILE *fp)
+{
+  PairLJETEN::read_restart_settings(fp);
+  if (comm->me == 0) utils::sfread(FLERR, &cut_inner, sizeof(double), 1, fp, nullptr, error);
+  MPI_Bcast(&cut_inner, 1, MPI_DOUBLE, 0, world);
+}
+
+/* ---------------------------------------------------------------------- */
+
+double PairLJETENSwitch::single(int /*i*/, int /*j*/, int itype, int jtype, double rsq,
+                                double /*factor_coul*/, double factor_lj, double &fforce)
+{
+  double r2inv, r3inv, r4inv, r5inv, r6inv, rinv, forcelj, philj;
+  const Param &p = params[itype][jtype];
+
+  r2inv = 1.0 / rsq;
+  r4inv = r2inv * r2inv;
+  r6inv = r4inv * r2inv;
+
+  if (rsq > cut_inner_sq) {
+    rinv = sqrt(r2inv);
+    r3inv = r2inv * rinv;
+    r5inv = r4inv * rinv;
+    forcelj = p.lj1 * k12 * r6inv * (r6inv - c6) - p.lj2 * k10 * r5inv * (r5inv - c5) +
+        p.lj3 * k6 * r3inv * (r3inv - c3);
+    philj = p.lj4 * k12 * (r6inv - c6) * (r6inv - c6) - p.lj5 * k10 * (r5inv - c5) * (r5inv - c5) +
+        p.lj6 * k6 * (r3inv - c3) * (r3inv - c3);
+  } else {
+    forcelj = r6inv * (p.lj1 * r6inv - p.lj2 * r4inv + p.lj3);
+    philj = p.lj4 * (r6inv * r6inv - shift12) - p.lj5 * (r6inv * r4inv - shift10) +
+        p.lj6 * (r6inv - shift6);
+  }
+  fforce = factor_lj * forcelj * r2inv;
+
+  return factor_lj * philj;
+}
+
+/* ----------------------------------------------------------------------
+   switched single() for n pairs, see PairLJETEN::single_batch()
+------------------------------------------------------------------------- */
+
+void PairLJETENSwitch::single_batch(int n, const int *itype, const int *jtype, const double *rsq,
+                                    const double *factor_lj, double *energy, double *fforce)
+{
+  double fone;
+  for (int k = 0; k < n; k++) {
+    energy[k] = PairLJETENSwitch::single(0, 0, itype[k], jtype[k], rsq[k], 0.0, factor_lj[k], fone);
+    if (fforce) fforce[k] = fone;
+  }
+}
@@ -0,0 +1,57 @@
+/* -*- c++ -*- ----------------------------------------------------------
+   LAMMPS - Large-scale Atomic/Molecular Massively Parallel Simulator
+   https://www.lammps.org/, Sandia National Laboratories
+   LAMMPS development team: developers@lammps.org
+
+   Copyright (2003) Sandia Corporation.  Under the terms of Contract
+   DE-AC04-94AL85000 with Sandia Corporation, the U.S. Government retains
+   certain rights in this software.  This software is distributed under
+   the GNU General Public License.
+
+   See the README file in the top-level LAMMPS directory.
+------------------------------------------------------------------------- */
+
+#ifdef PAIR_CLASS
+// clang-format off
+PairStyle(lj/eten/switch,PairLJETENSwitch);
+// clang-format on
+#else
+
+#ifndef LMP_PAIR_LJ_ETEN_SWITCH_H
+#define LMP_PAIR_LJ_ETEN_SWITCH_H
+
+#include "pair_lj_eten.h"
+
+namespace LAMMPS_NS {
+
+class PairLJETENSwitch : public PairLJETEN {
+ public:
+  PairLJETENSwitch(class LAMMPS *);
+  void compute(int, int) override;
+  void settings(int, char **) override;
+  void coeff(int, char **) override;
+  void init_style() override;
+  void write_restart_settings(FILE *) override;
+  void read_restart_settings(FILE *) override;
+  void write_data_all(FILE *) override;
+  double single(int, int, int, int, double, double, double, double &) override;
+  void single_batch(int, const int *, const int *, const double *, const double *, double *,
+                    double *) override;
+  bool energy_sets_supported() const override { return false; }
+
+ protected:
+  double cut_inner, cut_inner_sq;
+
+  // force switching constants for the r^-12, r^-10 and r^-6 terms:
+  // k = roff^(n/2) / (roff^(n/2) - ron^(n/2)), c = roff^(-n/2) and
+  // shift = (ron roff)^(-n/2) for the energy inside ron
+
+  double k12, k10, k6;
+  double c6, c5, c3;
+  double shift12, shift10, shift6;
+};
+
+}    // namespace LAMMPS_NS
+
+#endif
+#endif
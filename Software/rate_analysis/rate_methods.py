@@ -231,6 +231,45 @@ def inst_bias(data, colvars_count, colvars_maxrow_count, beta, biascol):
 
     return v_data, ix_col
 
+def load_eatr(record_file, history_file):
+    # Records and bias history V(t) written by the LAMMPS fix eatr, in place of colvar files.
+    # Records and "# trajectory <label> <id>" history blocks are keyed by the trajectory id. A run
+    # continued from a restart file writes both again, the last record and bias per time win.
+    records = {}
+    with open(record_file,'r') as f:
+        for line in f:
+            if line.startswith('#') or not line.strip():
+                continue
+            fields = line.split()
+            records[fields[1]] = (float(fields[2]), int(fields[3]) != 0)
+
+    blocks = {}
+    current = None
+    with open(history_file,'r') as f:
+        for line in f:
+            if line.startswith('# trajectory'):
+                current = blocks.setdefault(line.split()[3], {})
+            elif not line.startswith('#') and line.strip():
+                time, bias = [float(x) for x in line.split()[:2]]
+                current[time] = bias
+    missing = [uid for uid in records if uid not in blocks]
+    if missing:
+        raise ValueError(f"{history_file} has no bias history for {len(missing)} trajectories of {record_file}")
+
+    t = np.array([records[uid][0] for uid in records])
+    event = np.array([records[uid][1] for uid in records])
+    maxrow_count = max(len(blocks[uid]) for uid in records)
+    v_data = np.empty((len(records), maxrow_count))
+    v_data.fill(np.nan)
+    ix_col = None
+    for i, uid in enumerate(records):
+        times = sorted(blocks[uid])
+        v_data[i,:len(times)] = [blocks[uid][time] for time in times]
+        if len(times) == maxrow_count:
+            ix_col = np.array(times)
+
+    return t, event, v_data, ix_col
+
 def EATR_MLE_rate(v_data, t, event, gamma_bounds, beta, ix_col, cores, logTrick=False):
     def log_l_aa(gamma, event, t):
         spline = EATR_calculate_avg_acc(gamma, v_data, beta, ix_col, logTrick=logTrick)